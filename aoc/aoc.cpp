@@ -0,0 +1,122 @@
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <tuple>
+#include <vector>
+#include "../aoclib/aocio.hpp"
+#include "../aoclib/thread-pool.hpp"
+#include "days.hpp"
+
+/*
+    Runs several days in one process: all inputs are loaded (memory-mapped) up front, then every day
+    (both parts, one after another) is a task on a thread pool, so all days take about as long as the slowest one.
+    The time of a day covers splitting its input into lines and both parts (including any parsing they do, cf. days.hpp), but not loading the input.
+
+    Usage: aoc [--threads N] [--example] [day numbers, e.g. 3 7 12; all days by default]
+*/
+
+#ifndef AOC_INPUT_DIR
+#define AOC_INPUT_DIR ""
+#endif
+
+namespace aoc
+{
+
+struct DayResult {
+    std::string part_one, part_two;
+    std::string error;
+    double wall_ms = 0;
+};
+
+DayResult run_day(const Day& day, std::string_view input)
+{
+    DayResult result;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        std::tie(result.part_one, result.part_two) = day.solve(input);
+    } catch (const char* err) {
+        result.error = err;
+    } catch (const std::exception& err) {
+        result.error = err.what();
+    }
+    result.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t num_threads = aocutil::ThreadPool::default_num_threads();
+    bool use_example = false;
+    std::vector<const aoc::Day*> selected;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg {argv[i]};
+        if (arg == "--example") {
+            use_example = true;
+            continue;
+        }
+        const bool is_threads = arg == "--threads";
+        const std::string_view num_str = is_threads && i + 1 < argc ? std::string_view {argv[++i]} : arg;
+        const std::optional<int> num = aocio::parse_num(num_str);
+        if (!num || num.value() < 1 || (!is_threads && num.value() > static_cast<int>(aoc::days.size()))) {
+            std::cerr << "Usage: " << argv[0] << " [--threads N] [--example] [day numbers]\n";
+            return EXIT_FAILURE;
+        }
+        if (is_threads) {
+            num_threads = num.value();
+        } else {
+            selected.push_back(&aoc::days.at(num.value() - 1));
+        }
+    }
+    if (selected.empty()) {
+        for (const aoc::Day& day : aoc::days) {
+            selected.push_back(&day);
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // Load every input before starting any day.
+    std::vector<aocio::MappedInput> inputs(selected.size());
+    std::vector<bool> input_loaded(selected.size());
+    for (std::size_t i = 0; i < selected.size(); ++i) {
+        const std::string fname = std::string {AOC_INPUT_DIR} + std::string {selected[i]->name} + (use_example ? "-example.txt" : ".txt");
+        input_loaded[i] = inputs[i].open(fname);
+    }
+
+    std::vector<std::future<aoc::DayResult>> results(selected.size());
+    {
+        aocutil::ThreadPool pool {num_threads};
+        for (std::size_t i = 0; i < selected.size(); ++i) {
+            if (input_loaded[i]) {
+                results[i] = pool.submit([day = selected[i], input = inputs[i].contents()] {return aoc::run_day(*day, input);});
+            }
+        }
+    } // Waits for all days.
+
+    const double total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\n" << std::left << std::setw(8) << "Day" << std::setw(20) << "Part 1" << std::setw(20) << "Part 2"
+              << std::right << std::setw(12) << "Time (ms)" << "\n";
+    int num_failed = 0;
+    for (std::size_t i = 0; i < selected.size(); ++i) {
+        std::cout << std::left << std::setw(8) << selected[i]->name;
+        if (!input_loaded[i]) {
+            std::cout << "no input\n";
+            ++num_failed;
+            continue;
+        }
+        const aoc::DayResult result = results[i].get();
+        if (!result.error.empty()) {
+            std::cout << std::setw(40) << "Error: " + result.error;
+            ++num_failed;
+        } else {
+            std::cout << std::setw(20) << result.part_one << std::setw(20) << result.part_two;
+        }
+        std::cout << std::right << std::setw(12) << std::fixed << std::setprecision(3) << result.wall_ms << "\n";
+    }
+    std::cout << "Total (" << num_threads << " threads): " << std::fixed << std::setprecision(3) << total_ms << " ms\n";
+
+    return num_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/*
+    The days linked into the aoc runner; every day-NN library (built from day-NN/day-NN.cpp with AOC_DAY_LIBRARY defined) 
+    exposes day_NN::solve(input), which splits the input into lines once and returns the answers of both parts. 
+    Otherwise it does what the day's own executable does, e.g. a part which parses the lines into its own data structures still does so in both parts. Add new days to AOC_DAYS (and to TARGETS in CMakeLists.txt). 
+*/
+
+#define AOC_DAYS(X) X(01) X(02) X(03) X(04) X(05) X(06) X(07) X(08) X(09) X(10) X(11) X(12) X(13) X(14) X(15) X(16) X(17) X(18) X(19) X(20) X(21)
+
+#define AOC_DECLARE_DAY(nn) namespace day_##nn { std::pair<std::string, std::string> solve(std::string_view input); }
+AOC_DAYS(AOC_DECLARE_DAY)
+#undef AOC_DECLARE_DAY
+
+namespace aoc 
+{
+
+struct Day {
+    std::string_view name; // E.g. "day-07", i.e. the input is input/day-07.txt. 
+    std::pair<std::string, std::string> (*solve)(std::string_view input); 
+};
+
+#define AOC_DAY_ENTRY(nn) Day {.name = "day-" #nn, .solve = day_##nn::solve},
+inline constexpr std::array days {AOC_DAYS(AOC_DAY_ENTRY)}; 
+#undef AOC_DAY_ENTRY
+
+}
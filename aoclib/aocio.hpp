@@ -7,6 +7,25 @@
 #include <limits>
 #include <cassert>
 #include <optional>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <charconv>
+#include <type_traits>
+#include <string_view>
+#include <utility>
+#include <cstring>
+#include <cerrno>
+#include <cctype>
+#include <iterator>
+#include <algorithm>
+#include <span>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "byte-scan.hpp"
+#include "timing.hpp"
 
 #ifndef AOC_INPUT_PATH
 #define AOC_INPUT_PATH ""
@@ -35,38 +54,334 @@ inline bool file_getlines(std::string_view fname, std::vector<std::string>& line
     return true;
 }
 
-inline void remove_leading_empty_lines(std::vector<std::string>& lines)
+// Splits contents at '\n' (same line semantics as file_getlines); the default string_views point into contents. 
+template <typename Line = std::string_view>
+std::vector<Line> split_lines(std::string_view contents)
 {
-    auto line = lines.begin(); 
-    while (line != lines.end()) {
-        std::size_t idx = line->find_first_not_of(" \t", 0); 
-        if (idx == std::string::npos) {
-            lines.erase(line);
-            line = lines.begin();
-        } else {
-            assert(line->size());
-            break;
-        }
+    std::vector<Line> lines; 
+    constexpr ByteSet newline {"\n"}; 
+    std::size_t start = 0; 
+    for_each_byte_match(contents, newline, [&lines, &start, contents](std::size_t nl_idx) {
+        lines.emplace_back(contents.substr(start, nl_idx - start));
+        start = nl_idx + 1; 
+    });
+    if (start < contents.size()) { // Last line without a trailing '\n'.
+        lines.emplace_back(contents.substr(start));
     }
+    return lines; 
 }
 
-inline void remove_trailing_empty_lines(std::vector<std::string>& lines)
+/*
+    Read-only memory mapping of an input file. The lines are indexed with one scan for '\n' and
+    are string_views into the mapping (without the '\n'), i.e. nothing is copied, and the lines 
+    are only valid as long as their MappedInput is alive. (Same line semantics as file_getlines.)
+*/
+class MappedInput 
+{
+    const char* data_ = nullptr; 
+    std::size_t size_ = 0; 
+    std::vector<std::string_view> lines_; 
+
+    void unmap() 
+    {
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_); 
+        }
+        data_ = nullptr;
+        size_ = 0; 
+        lines_.clear(); 
+    }
+
+    void index_lines() 
+    {
+        lines_ = split_lines(contents()); 
+    }
+
+public:
+    MappedInput() = default; 
+    MappedInput(const MappedInput&) = delete; 
+    MappedInput& operator=(const MappedInput&) = delete; 
+
+    MappedInput(MappedInput&& other) noexcept : data_(other.data_), size_(other.size_), lines_(std::move(other.lines_)) 
+    {
+        other.data_ = nullptr; 
+        other.size_ = 0; 
+    }
+
+    MappedInput& operator=(MappedInput&& other) noexcept
+    {
+        if (this != &other) {
+            unmap(); 
+            data_ = std::exchange(other.data_, nullptr); 
+            size_ = std::exchange(other.size_, 0); 
+            lines_ = std::move(other.lines_); 
+        }
+        return *this; 
+    }
+
+    ~MappedInput() 
+    {
+        unmap(); 
+    }
+
+    bool open(std::string_view fname)
+    {
+        unmap(); 
+        const std::string path {fname}; 
+        int fd = ::open(path.c_str(), O_RDONLY); 
+        if (fd == -1) {
+            std::cerr << "Cannot open file " << fname << "\n";
+            return false; 
+        }
+        struct stat st; 
+        if (fstat(fd, &st) == -1) {
+            std::cerr << "Cannot stat file " << fname << "\n";
+            ::close(fd); 
+            return false; 
+        }
+        if (st.st_size == 0) { // mmap does not accept empty mappings; an empty file simply has no lines. 
+            ::close(fd); 
+            return true; 
+        }
+
+        void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0); 
+        ::close(fd); // The mapping stays valid after closing the descriptor. 
+        if (mapped == MAP_FAILED) {
+            std::cerr << "Cannot map file " << fname << "\n";
+            return false; 
+        }
+        madvise(mapped, st.st_size, MADV_SEQUENTIAL); 
+        data_ = static_cast<const char*>(mapped); 
+        size_ = st.st_size; 
+        index_lines(); 
+        return true; 
+    }
+
+    const std::vector<std::string_view>& lines() const {
+        return lines_; 
+    }
+
+    std::string_view contents() const {
+        return std::string_view {data_, size_}; 
+    }
+
+    std::size_t size() const {
+        return lines_.size(); 
+    }
+
+    std::string_view operator[](std::size_t line_idx) const 
+    {
+        assert(line_idx < lines_.size()); 
+        return lines_[line_idx]; 
+    }
+
+    auto begin() const {
+        return lines_.cbegin(); 
+    }
+    auto end() const {
+        return lines_.cend(); 
+    }
+};
+
+/*
+    Streams the lines of a file through a fixed-size buffer, i.e. memory use is O(buffer size) instead of O(file size), 
+    for days which only need one line at a time. The partial line at the end of the buffer is carried over to the front 
+    before the next read; if a single line does not fit the buffer grows (doubles). 
+    The lines returned by next (or the iterators) are only valid until the next line is read. (Same line semantics as file_getlines.)
+    Usage: for (std::string_view line : reader) {...} -- which is a single pass; call rewind() to read the file again. 
+*/
+class LineReader 
+{
+    int fd_ = -1; 
+    std::vector<char> buf_; 
+    std::size_t begin_ = 0, end_ = 0; // The unconsumed bytes are buf_[begin_, end_). 
+    bool eof_ = false; 
+
+    void close() 
+    {
+        if (fd_ != -1) {
+            ::close(fd_); 
+        }
+        fd_ = -1; 
+    }
+
+    // Moves the carried-over partial line to the front of the buffer and fills the rest. 
+    void refill() 
+    {
+        const std::size_t carry = end_ - begin_; 
+        if (begin_ > 0) {
+            std::memmove(buf_.data(), buf_.data() + begin_, carry); 
+        }
+        begin_ = 0; 
+        end_ = carry; 
+        if (end_ == buf_.size()) { // The line is longer than the buffer. 
+            buf_.resize(buf_.size() * 2); 
+        }
+        ssize_t num_read = 0; 
+        do {
+            num_read = ::read(fd_, buf_.data() + end_, buf_.size() - end_); 
+        } while (num_read == -1 && errno == EINTR); 
+        if (num_read == -1) {
+            throw std::runtime_error("LineReader: read failed"); 
+        }
+        if (num_read == 0) {
+            eof_ = true; 
+        }
+        end_ += num_read; 
+    }
+
+public: 
+    static constexpr std::size_t default_buffer_size = 64 * 1024; 
+
+    class Iterator 
+    {
+        LineReader* reader_ = nullptr; 
+        std::string_view line_; 
+    public: 
+        using value_type = std::string_view; 
+        using difference_type = std::ptrdiff_t; 
+
+        Iterator() = default; 
+        explicit Iterator(LineReader* reader) : reader_{reader} 
+        {
+            ++(*this); 
+        }
+        std::string_view operator*() const {
+            return line_; 
+        }
+        Iterator& operator++() 
+        {
+            if (!reader_->next(line_)) {
+                reader_ = nullptr; 
+            }
+            return *this; 
+        }
+        void operator++(int) {
+            ++(*this); 
+        }
+        bool operator==(std::default_sentinel_t) const {
+            return reader_ == nullptr; 
+        }
+    };
+
+    explicit LineReader(std::size_t buffer_size = default_buffer_size) : buf_(std::max<std::size_t>(buffer_size, 1)) {}
+    LineReader(const LineReader&) = delete; 
+    LineReader& operator=(const LineReader&) = delete; 
+
+    ~LineReader() 
+    {
+        close(); 
+    }
+
+    bool open(std::string_view fname) 
+    {
+        close(); 
+        const std::string path {fname}; 
+        fd_ = ::open(path.c_str(), O_RDONLY); 
+        if (fd_ == -1) {
+            std::cerr << "Cannot open file " << fname << "\n";
+            return false; 
+        }
+#ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL); 
+#endif
+        begin_ = end_ = 0; 
+        eof_ = false; 
+        return true; 
+    }
+
+    // Starts reading from the beginning of the file again (e.g. for the second part). 
+    bool rewind() 
+    {
+        if (fd_ == -1 || ::lseek(fd_, 0, SEEK_SET) == -1) {
+            return false; 
+        }
+        begin_ = end_ = 0; 
+        eof_ = false; 
+        return true; 
+    }
+
+    // Returns false if there are no more lines. 
+    bool next(std::string_view& line) 
+    {
+        assert(fd_ != -1); 
+        while (true) {
+            const void* nl = std::memchr(buf_.data() + begin_, '\n', end_ - begin_); 
+            if (nl) {
+                const std::size_t nl_idx = static_cast<const char*>(nl) - buf_.data(); 
+                line = std::string_view {buf_.data() + begin_, nl_idx - begin_}; 
+                begin_ = nl_idx + 1; 
+                return true; 
+            }
+            if (eof_) {
+                if (begin_ == end_) {
+                    return false; 
+                }
+                line = std::string_view {buf_.data() + begin_, end_ - begin_}; // Last line without a trailing '\n'. 
+                begin_ = end_; 
+                return true; 
+            }
+            refill(); 
+        }
+    }
+
+    Iterator begin() {
+        return Iterator {this}; 
+    }
+    std::default_sentinel_t end() const {
+        return std::default_sentinel; 
+    }
+};
+
+inline bool has_arg(int argc, char* argv[], std::string_view arg)
 {
-    auto line = lines.rbegin(); 
-    while (line != lines.rend()) {
-        std::size_t idx = line->find_first_not_of(" \t", 0); 
-        if (idx == std::string::npos) {
-            lines.erase(std::next(line).base()); // cf. https://stackoverflow.com/questions/1830158/how-to-call-erase-with-a-reverse-iterator [1]
-            line = lines.rbegin();
-        } else {
-            assert(line->size());
-            break;
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] == arg) {
+            return true; 
         }
     }
+    return false; 
+}
+
+inline bool is_blank_line(std::string_view line) 
+{
+    return line.find_first_not_of(" \t") == std::string_view::npos; 
+}
+
+/*
+    Returns the view of lines without leading (and trailing) blank lines, i.e. one scan from the front and one from the back 
+    and nothing is moved or copied. Works for std::vector<std::string> (from file_getlines) and std::vector<std::string_view> 
+    (from MappedInput); the span is only valid as long as lines is. 
+*/
+template <typename Line>
+std::span<const Line> trim_leading_empty_lines(const std::vector<Line>& lines)
+{
+    auto first = std::find_if_not(lines.begin(), lines.end(), [](std::string_view line) {return is_blank_line(line);}); 
+    return std::span<const Line> {first, lines.end()}; 
+}
+
+template <typename Line>
+std::span<const Line> trim_empty_lines(const std::vector<Line>& lines)
+{
+    std::span<const Line> trimmed = trim_leading_empty_lines(lines); 
+    auto last = std::find_if_not(trimmed.rbegin(), trimmed.rend(), [](std::string_view line) {return is_blank_line(line);}); 
+    return trimmed.first(trimmed.rend() - last); 
+}
+
+inline void remove_leading_empty_lines(std::vector<std::string>& lines)
+{
+    const std::size_t num_empty = lines.size() - trim_leading_empty_lines(lines).size(); 
+    lines.erase(lines.begin(), lines.begin() + num_empty); // A single erase, i.e. the remaining lines are only moved once. 
+}
+
+inline void remove_trailing_empty_lines(std::vector<std::string>& lines)
+{
+    auto last = std::find_if_not(lines.rbegin(), lines.rend(), [](std::string_view line) {return is_blank_line(line);}); 
+    lines.erase(last.base(), lines.end()); // cf. https://stackoverflow.com/questions/1830158/how-to-call-erase-with-a-reverse-iterator [1]
     // [1] last retrieved 2024-06-25
 }
 
-inline void line_tokenise(const std::string& line, const std::string& delims, const std::string& preserved_delims, std::vector<std::string>& tokens)
+inline void line_tokenise(std::string_view line, const std::string& delims, const std::string& preserved_delims, std::vector<std::string>& tokens)
 {
     for (char d : preserved_delims) {
         if (delims.find(d) == std::string::npos) {
@@ -80,12 +395,12 @@ inline void line_tokenise(const std::string& line, const std::string& delims, co
         if (token_end_pos == std::string::npos) {
             token_end_pos = line.size();
         }
-        std::string token = line.substr(start_pos, token_end_pos - start_pos);
+        std::string token {line.substr(start_pos, token_end_pos - start_pos)};
         if (token.size()) {
             tokens.push_back(token);
         }
         
-        if (token_end_pos != std::string::npos && preserved_delims.size() && preserved_delims.find(line[token_end_pos]) != std::string::npos) {
+        if (token_end_pos < line.size() && preserved_delims.size() && preserved_delims.find(line[token_end_pos]) != std::string::npos) {
             tokens.push_back(std::string{line[token_end_pos]});
         }
 
@@ -93,6 +408,83 @@ inline void line_tokenise(const std::string& line, const std::string& delims, co
     }
 }
 
+/*
+    256-entry lookup table of delimiter classes, so classifying a character is a single table load 
+    (instead of line_tokenise's find_first_of per token). Build it once (it can be constexpr) and reuse it for every line.
+*/
+class Delims 
+{
+public:
+    enum Class : uint8_t {None = 0, Delim = 1, Preserved = 2};
+
+private:
+    std::array<uint8_t, 256> table {}; 
+    ByteSet scan_set; // Only used if there are at most ByteSet::max_size delimiters.
+    bool use_scan_set = true; 
+
+public:
+    constexpr Delims(std::string_view delims, std::string_view preserved_delims = "") 
+    {
+        for (char d : delims) {
+            table[static_cast<unsigned char>(d)] = Delim; 
+            if (use_scan_set && !scan_set.contains(d)) {
+                if (scan_set.size() == ByteSet::max_size) {
+                    use_scan_set = false; 
+                } else {
+                    scan_set.insert(d); 
+                }
+            }
+        }
+        for (char d : preserved_delims) {
+            if (table[static_cast<unsigned char>(d)] == None) {
+                throw std::invalid_argument("Preserved delim not in delims");
+            }
+            table[static_cast<unsigned char>(d)] = Preserved; 
+        }
+    }
+
+    constexpr uint8_t classify(char c) const {
+        return table[static_cast<unsigned char>(c)]; 
+    }
+
+    constexpr const ByteSet* byte_set() const {
+        return use_scan_set ? &scan_set : nullptr; 
+    }
+};
+
+/*
+    Same tokens as line_tokenise, but as string_views into line (so they are only valid as long as line's storage is). 
+    tokens is cleared first but keeps its capacity, so reusing the same vector for every line does not allocate.
+*/
+inline void line_tokenise(std::string_view line, const Delims& delims, std::vector<std::string_view>& tokens)
+{
+    tokens.clear(); 
+    std::size_t start_pos = 0; 
+    auto on_delim = [&](std::size_t i) {
+        if (i > start_pos) {
+            tokens.push_back(line.substr(start_pos, i - start_pos)); 
+        }
+        if (delims.classify(line[i]) == Delims::Preserved) {
+            tokens.push_back(line.substr(i, 1)); 
+        }
+        start_pos = i + 1; 
+    };
+
+    constexpr std::size_t min_scan_len = 16; // Shorter lines are not worth setting up the SIMD kernel.
+    if (const ByteSet* set = delims.byte_set(); set && line.size() >= min_scan_len) {
+        for_each_byte_match(line, *set, on_delim); 
+    } else {
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            if (delims.classify(line[i]) != Delims::None) {
+                on_delim(i); 
+            }
+        }
+    }
+    if (start_pos < line.size()) {
+        tokens.push_back(line.substr(start_pos)); 
+    }
+}
+
 static inline std::string str_without_whitespace(std::string_view str) 
 {
     std::string result; 
@@ -109,24 +501,87 @@ static inline void str_remove_whitespace(std::string& str)
 }
 
 
-static inline std::optional<int> parse_num(const std::string &str)
+template <typename IntT>
+struct ParsedInt {
+    IntT value; 
+    std::size_t num_read; 
+};
+
+/*
+    Parses the integer at the very start of str with std::from_chars (no locale, no exceptions, no allocation). 
+    Unlike parse_num, neither leading whitespace nor a '+' is skipped. 
+    Returns the value and the number of characters it consumed, or nothing if str does not start with an integer which fits into IntT. 
+*/
+template <typename IntT = int>
+static inline std::optional<ParsedInt<IntT>> parse_int(std::string_view str)
 {
-    size_t num_read = 0; 
-    int n = std::stoi(str, &num_read); 
-    if (num_read == 0) {
+    IntT value {}; 
+    const auto [end_ptr, err] = std::from_chars(str.data(), str.data() + str.size(), value); 
+    if (err != std::errc{}) {
         return {};
     }
-    return n; 
+    return ParsedInt<IntT>{.value = value, .num_read = static_cast<std::size_t>(end_ptr - str.data())}; 
+}
+
+/*
+    Appends every integer of line to out in one scan (out is cleared first, but keeps its capacity). 
+    A '-' directly in front of a digit is a sign (for signed IntT) if it starts the line or follows a character which is 
+    neither a letter nor a digit, e.g. "x=-5, -3" gives -5 and -3, but "a-5" and "3-5" give 5 and 3 and 5. 
+    Everything else which is not a digit is skipped (so labels like "Time:" are fine, but garbage is not detected). 
+    Returns false if an integer does not fit into IntT. 
+*/
+template <typename IntT = int>
+static inline bool extract_all_ints(std::string_view line, std::vector<IntT>& out)
+{
+    out.clear(); 
+    std::size_t i = 0; 
+    while (i < line.size()) {
+        const bool is_digit = line[i] >= '0' && line[i] <= '9'; 
+        const bool is_sign = std::is_signed_v<IntT> && line[i] == '-' && i + 1 < line.size() && line[i + 1] >= '0' && line[i + 1] <= '9' 
+                             && (i == 0 || !std::isalnum(static_cast<unsigned char>(line[i - 1]))); 
+        if (!is_digit && !is_sign) {
+            ++i; 
+            continue; 
+        }
+        auto parsed = parse_int<IntT>(line.substr(i)); 
+        if (!parsed) {
+            return false; 
+        }
+        out.push_back(parsed->value); 
+        i += parsed->num_read; 
+    }
+    return true; 
+}
+
+// Skips leading whitespace and a '+' like std::stoi does.
+static inline std::string_view strip_num_prefix(std::string_view str)
+{
+    std::size_t prefix = 0; 
+    while (prefix < str.size() && (str[prefix] == ' ' || str[prefix] == '\t')) {
+        ++prefix; 
+    }
+    if (prefix + 1 < str.size() && str[prefix] == '+') {
+        ++prefix; 
+    }
+    return str.substr(prefix); 
+}
+
+static inline std::optional<int> parse_num(std::string_view str)
+{
+    auto parsed = parse_int<int>(strip_num_prefix(str)); 
+    if (!parsed) {
+        return {};
+    }
+    return parsed->value; 
 } 
 
-static inline std::optional<int64_t> parse_num_i64(const std::string& str)
+static inline std::optional<int64_t> parse_num_i64(std::string_view str)
 {
-    size_t num_read = 0; 
-    int64_t n = std::stoll(str, &num_read); 
-    if (num_read == 0) {
+    auto parsed = parse_int<int64_t>(strip_num_prefix(str)); 
+    if (!parsed) {
         return {};
     }
-    return n; 
+    return parsed->value; 
 } 
 
 static inline std::optional<int> parse_digit(char c)
@@ -139,63 +594,128 @@ static inline std::optional<int> parse_digit(char c)
     }
 }
 
+// Maps '0'-'9', 'a'-'f' and 'A'-'F' to their value, all other chars to invalid_hex_digit. 
+constexpr uint8_t invalid_hex_digit = 0xff; 
+constexpr std::array<uint8_t, 256> hex_digit_table = [] {
+    std::array<uint8_t, 256> table {}; 
+    table.fill(invalid_hex_digit); 
+    for (int i = 0; i < 10; ++i) {
+        table['0' + i] = i; 
+    }
+    for (int i = 0; i < 6; ++i) {
+        table['a' + i] = table['A' + i] = 10 + i; 
+    }
+    return table; 
+}(); 
+
+// Parses e.g. "ff", "#70c710" or "0x1A" (surrounding whitespace is ignored).
 template <typename IntT = int>
 static inline std::optional<IntT> parse_hex(std::string_view str)
 {
-    if (str.size() == 0) {
+    const std::size_t first = str.find_first_not_of(" \t"); 
+    if (first == std::string_view::npos) {
+        return {}; 
+    }
+    str = str.substr(first, str.find_last_not_of(" \t") - first + 1); 
+
+    if (str.size() >= 2 && str[0] == '#') { // Handle # and 0x prefixes
+        str.remove_prefix(1); 
+    } else if (str.size() >= 3 && str[0] == '0' && str[1] == 'x') {
+        str.remove_prefix(2); 
+    }
+
+    IntT res = 0; 
+    uint8_t invalid = 0; 
+    for (char c : str) {
+        const uint8_t digit = hex_digit_table[static_cast<unsigned char>(c)]; 
+        invalid |= digit; // Only invalid_hex_digit has the high bit set. 
+        res = res * 16 + (digit & 0xf); 
+    }
+    if (invalid & 0x80) {
         return {};
     }
+    return res; 
+}
 
-    int prefix = 0; 
-    while (str.at(prefix) == ' ' || str.at(prefix) == '\t') { // Remove leading whitespace
-        ++prefix; 
+// Exactly six hex digits without prefix, e.g. the "70c710" of a "#70c710" colour. 
+inline std::optional<uint32_t> parse_hex6(std::string_view str)
+{
+    if (str.size() != 6) {
+        return {}; 
+    }
+    uint32_t res = 0; 
+    uint8_t invalid = 0; 
+    for (int i = 0; i < 6; ++i) {
+        const uint8_t digit = hex_digit_table[static_cast<unsigned char>(str[i])]; 
+        invalid |= digit; 
+        res = (res << 4) | (digit & 0xf); 
     }
-    str = str.substr(prefix, str.size());
+    if (invalid & 0x80) {
+        return {}; 
+    }
+    return res; 
+}
 
-    if (str.size() >= 2) { // Handle # and 0x prefixes
-        if (str.at(0) == '#') {
-            str = str.substr(1, str.size());
-        } else if (str.size() >= 3) {
-            if (str.at(0) == '0' && str.at(1) == 'x') {
-                str = str.substr(2, str.size());
-            }
+/*
+    parse_hex6 for many fields at once, e.g. all colours of a dig plan (out must have room for fields.size() values).
+    Returns false if any field is not exactly six hex digits. 
+    With SSE2, two fields are decoded per iteration: their digits are converted to nibbles with 
+    (c & 0xf) + (is_letter ? 9 : 0), adjacent nibbles are merged into bytes within the 16-bit lanes and packed. 
+*/
+inline bool parse_hex6_batch(std::span<const std::string_view> fields, uint32_t* out)
+{
+    std::size_t i = 0; 
+#if defined(__SSE2__)
+    const __m128i zero_chars = _mm_set1_epi8('0'); 
+    const __m128i low_byte = _mm_set1_epi16(0x00ff); 
+    for (; i + 2 <= fields.size(); i += 2) {
+        if (fields[i].size() != 6 || fields[i + 1].size() != 6) {
+            return false; 
         }
-    } 
- 
-    int end_idx = std::ssize(str) - 1; 
-    while (str.at(end_idx) == ' ' || str.at(end_idx) == '\t') { // Remove trailing whitespace. 
-        end_idx -= 1; 
-    }
+        alignas(16) char buf[16]; 
+        _mm_store_si128(reinterpret_cast<__m128i*>(buf), zero_chars); // Pads every field to eight digits with '0'. 
+        std::memcpy(buf, fields[i].data(), 6); 
+        std::memcpy(buf + 8, fields[i + 1].data(), 6); 
+        const __m128i chars = _mm_load_si128(reinterpret_cast<const __m128i*>(buf)); 
 
-    IntT res = 0; 
-    IntT fac = 1; 
-    for (int i = end_idx; i >= 0; --i, fac *= 16) {
-        char sym = str.at(i); 
-        IntT digit = 0; 
-        if (sym >= '0' && sym <= '9') {
-            digit = aocio::parse_digit(sym).value(); 
-        } else {
-            digit = 10 + (sym - 'a'); 
-            if (digit < 10 || digit > 15) { // Try uppercase. 
-                digit = 10 + (sym - 'A'); 
-            }
-            if (digit < 10 || digit > 15) {
-                return {};
-            }
+        const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20)); 
+        const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1))); 
+        const __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1))); 
+        if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) {
+            return false; 
         }
-        res += digit * fac;
+        const __m128i nibbles = _mm_add_epi8(_mm_and_si128(chars, _mm_set1_epi8(0x0f)), _mm_and_si128(is_letter, _mm_set1_epi8(9))); 
+        // Lane = first digit | (second digit << 8) -> (first digit << 4) | second digit
+        const __m128i bytes = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, low_byte), 4), _mm_srli_epi16(nibbles, 8)); 
+        uint64_t packed; // rr gg bb 00 rr gg bb 00 (in memory order)
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&packed), _mm_packus_epi16(bytes, bytes)); 
+        out[i] = ((packed & 0xff) << 16) | (packed & 0xff00) | ((packed >> 16) & 0xff); 
+        out[i + 1] = ((packed >> 16) & 0xff0000) | ((packed >> 32) & 0xff00) | ((packed >> 48) & 0xff); 
     }
-    return res; 
+#endif
+    for (; i < fields.size(); ++i) {
+        const std::optional<uint32_t> res = parse_hex6(fields[i]); 
+        if (!res) {
+            return false; 
+        }
+        out[i] = res.value(); 
+    }
+    return true; 
 }
 
-inline void print_day() 
+// E.g. "Day-07" (from AOC_SRC_DIR). 
+inline std::string day_name() 
 {
     std::string day_name {std::filesystem::path(AOC_SRC_DIR).parent_path().filename()};
     
     if (day_name.size()) {
         day_name[0] = std::toupper(day_name[0]);
     }
+    return day_name; 
+}
 
+inline void print_day() 
+{
     std::string debug_release;
     #ifdef NDEBUG
     debug_release = "Release";
@@ -203,6 +723,80 @@ inline void print_day()
     debug_release = "Debug";
     #endif
 
-    std::cout << day_name << " (" << debug_release << ")\n";
+    std::cout << day_name() << " (" << debug_release << ")\n";
+}
+
+// Runs f as the given phase (cf. timing.hpp) and returns its result, e.g. int p1 = timed_phase("part1", [&] { return part_one(lines); }); 
+template <typename Fn>
+auto timed_phase(std::string_view phase_name, Fn&& f) 
+{
+    ScopedPhase phase {phase_name}; 
+    return f(); 
+}
+
+struct TimingOptions {
+    int repeat = 1, warmup = 0; 
+    bool report = false, json = false; 
+};
+
+// --repeat N, --warmup M, --time (print the timing table), --json (print the timings as JSON). Other arguments are ignored. 
+inline std::optional<TimingOptions> parse_timing_options(int argc, char* argv[]) 
+{
+    TimingOptions opts; 
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg {argv[i]}; 
+        if (arg == "--repeat" || arg == "--warmup") {
+            const std::optional<ParsedInt<int>> n = i + 1 < argc ? parse_int<int>(argv[i + 1]) : std::nullopt; 
+            if (!n || n->num_read != std::strlen(argv[i + 1]) || n->value < (arg == "--repeat" ? 1 : 0)) {
+                std::cerr << "Invalid argument for " << arg << "\n"; 
+                return std::nullopt; 
+            }
+            (arg == "--repeat" ? opts.repeat : opts.warmup) = n->value; 
+            opts.report = true; 
+            ++i; 
+        } else if (arg == "--time") {
+            opts.report = true; 
+        } else if (arg == "--json") {
+            opts.report = opts.json = true; 
+        }
+    }
+    return opts; 
+}
+
+/*
+    Calls run (which returns the exit code of the day) warmup + repeat times; only the output of the last run is printed 
+    and only the repeated runs are timed. Afterwards, the timings of the phases are printed if requested (cf. parse_timing_options).
+*/
+template <typename RunFn>
+int timed_runs(int argc, char* argv[], RunFn&& run) 
+{
+    const std::optional<TimingOptions> opts = parse_timing_options(argc, argv); 
+    if (!opts) {
+        return EXIT_FAILURE; 
+    }
+    const int num_runs = opts->warmup + opts->repeat; 
+    for (int i = 0; i < num_runs; ++i) {
+        if (i == opts->warmup) {
+            phase_timings().clear(); 
+        }
+        if (i != num_runs - 1) {
+            std::cout.setstate(std::ios::failbit); // Silences std::cout until clear(). 
+        }
+        int exit_code = EXIT_SUCCESS; 
+        try {
+            exit_code = run(); 
+        } catch (...) {
+            std::cout.clear(); 
+            throw; 
+        }
+        std::cout.clear(); 
+        if (exit_code != EXIT_SUCCESS) {
+            return exit_code; 
+        }
+    }
+    if (opts->report) {
+        phase_timings().report(std::cout, day_name(), opts->json); 
+    }
+    return EXIT_SUCCESS; 
+}
 }
-}
\ No newline at end of file
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "grid.hpp"
+#include "vec.hpp"
+
+namespace aocutil
+{
+
+/*
+    2D grid of bits; every row is packed into uint64_t words (bit x % 64 of word x / 64 is cell x),
+    so shifts, boolean operations and popcount handle 64 cells per instruction.
+    The unused bits of the last word of a row are always zero.
+    Shifts move the cells by n positions (e.g. shift_left: cell (x, y) ends up at (x - n, y));
+    cells shifted off the grid are dropped, the vacated cells are cleared.
+*/
+class BitGrid
+{
+    static constexpr int word_bits = 64;
+
+    std::vector<uint64_t> words;
+    int width_ = 0, height_ = 0;
+    int words_per_row = 0;
+    uint64_t last_word_mask = 0; // The bits of the last word of a row which are on the grid.
+
+    uint64_t* row_ptr(int y) {
+        return words.data() + static_cast<std::size_t>(y) * words_per_row;
+    }
+    const uint64_t* row_ptr(int y) const {
+        return words.data() + static_cast<std::size_t>(y) * words_per_row;
+    }
+
+    void clear_padding()
+    {
+        for (int y = 0; y < height_; ++y) {
+            row_ptr(y)[words_per_row - 1] &= last_word_mask;
+        }
+    }
+
+    void check_same_size(const BitGrid& other, const char* err) const
+    {
+        if (width_ != other.width_ || height_ != other.height_) {
+            throw std::invalid_argument(err);
+        }
+    }
+
+    // dst = src moved by n cells towards x - 1 (for n < width).
+    static void row_shift_left(uint64_t* dst, const uint64_t* src, int num_words, int n)
+    {
+        const int word_shift = n / word_bits, bit_shift = n % word_bits;
+        for (int w = 0; w < num_words; ++w) {
+            const int src_w = w + word_shift;
+            uint64_t res = src_w < num_words ? src[src_w] >> bit_shift : 0;
+            if (bit_shift && src_w + 1 < num_words) {
+                res |= src[src_w + 1] << (word_bits - bit_shift);
+            }
+            dst[w] = res;
+        }
+    }
+
+    // dst = src moved by n cells towards x + 1; the caller has to clear the padding bits.
+    static void row_shift_right(uint64_t* dst, const uint64_t* src, int num_words, int n)
+    {
+        const int word_shift = n / word_bits, bit_shift = n % word_bits;
+        for (int w = num_words - 1; w >= 0; --w) {
+            const int src_w = w - word_shift;
+            uint64_t res = src_w >= 0 ? src[src_w] << bit_shift : 0;
+            if (bit_shift && src_w - 1 >= 0) {
+                res |= src[src_w - 1] >> (word_bits - bit_shift);
+            }
+            dst[w] = res;
+        }
+    }
+
+public:
+    BitGrid() = default;
+
+    BitGrid(int width, int height) : width_{width}, height_{height}
+    {
+        if (width <= 0 || height <= 0) {
+            throw std::invalid_argument("BitGrid::BitGrid: Invalid size");
+        }
+        words_per_row = (width + word_bits - 1) / word_bits;
+        last_word_mask = width % word_bits ? (uint64_t{1} << (width % word_bits)) - 1 : ~uint64_t{0};
+        words.resize(static_cast<std::size_t>(words_per_row) * height);
+    }
+
+    // Sets the cells for which pred(elem) is true, e.g. BitGrid::from_grid(grid, [](char c) {return c != '#';}). 
+    // (grid can be anything with width(), height() and row(y), e.g. a Grid or a GridView.)
+    template <typename GridT, typename Pred>
+    static BitGrid from_grid(const GridT& grid, Pred&& pred)
+    {
+        BitGrid bits {grid.width(), grid.height()};
+        for (int y = 0; y < grid.height(); ++y) {
+            const auto row = grid.row(y);
+            uint64_t* row_words = bits.row_ptr(y);
+            for (int x = 0; x < grid.width(); ++x) {
+                row_words[x / word_bits] |= static_cast<uint64_t>(static_cast<bool>(pred(row[x]))) << (x % word_bits);
+            }
+        }
+        return bits;
+    }
+
+    int width() const {
+        return width_;
+    }
+    int height() const {
+        return height_;
+    }
+
+    bool pos_on_grid(int x, int y) const {
+        return x >= 0 && x < width_ && y >= 0 && y < height_;
+    }
+    bool pos_on_grid(const Vec2<int>& pos) const {
+        return pos_on_grid(pos.x, pos.y);
+    }
+
+    bool test(int x, int y) const
+    {
+        assert(pos_on_grid(x, y));
+        return (row_ptr(y)[x / word_bits] >> (x % word_bits)) & 1;
+    }
+    bool test(const Vec2<int>& pos) const {
+        return test(pos.x, pos.y);
+    }
+
+    void set(int x, int y, bool value = true)
+    {
+        if (!pos_on_grid(x, y)) {
+            throw std::out_of_range("BitGrid set: invalid position");
+        }
+        uint64_t& word = row_ptr(y)[x / word_bits];
+        const uint64_t bit = uint64_t{1} << (x % word_bits);
+        word = value ? word | bit : word & ~bit;
+    }
+    void set(const Vec2<int>& pos, bool value = true) {
+        set(pos.x, pos.y, value);
+    }
+
+    void clear() {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+    // The number of set cells.
+    int64_t popcount() const
+    {
+        int64_t cnt = 0;
+        for (uint64_t word : words) {
+            cnt += std::popcount(word);
+        }
+        return cnt;
+    }
+
+    std::span<const uint64_t> row_words(int y) const
+    {
+        assert(y >= 0 && y < height_);
+        return {row_ptr(y), static_cast<std::size_t>(words_per_row)};
+    }
+
+    BitGrid& shift_left(int n = 1)
+    {
+        assert(n >= 0);
+        if (n >= width_) {
+            clear();
+            return *this;
+        }
+        for (int y = 0; y < height_; ++y) {
+            row_shift_left(row_ptr(y), row_ptr(y), words_per_row, n); // In place, as the source words are ahead of the destination.
+        }
+        return *this;
+    }
+
+    BitGrid& shift_right(int n = 1)
+    {
+        assert(n >= 0);
+        if (n >= width_) {
+            clear();
+            return *this;
+        }
+        for (int y = 0; y < height_; ++y) {
+            row_shift_right(row_ptr(y), row_ptr(y), words_per_row, n);
+        }
+        clear_padding();
+        return *this;
+    }
+
+    BitGrid& shift_up(int n = 1)
+    {
+        assert(n >= 0);
+        n = std::min(n, height_);
+        const std::size_t offset = static_cast<std::size_t>(n) * words_per_row;
+        std::copy(words.begin() + offset, words.end(), words.begin());
+        std::fill(words.end() - offset, words.end(), 0);
+        return *this;
+    }
+
+    BitGrid& shift_down(int n = 1)
+    {
+        assert(n >= 0);
+        n = std::min(n, height_);
+        const std::size_t offset = static_cast<std::size_t>(n) * words_per_row;
+        std::copy_backward(words.begin(), words.end() - offset, words.end());
+        std::fill(words.begin(), words.begin() + offset, 0);
+        return *this;
+    }
+
+    // The cells with at least one set cell to their left, right, top or bottom (in one pass, without temporary grids).
+    BitGrid adjacent() const
+    {
+        BitGrid res {width_, height_};
+        std::vector<uint64_t> shifted(words_per_row);
+        for (int y = 0; y < height_; ++y) {
+            uint64_t* dst = res.row_ptr(y);
+            const uint64_t* src = row_ptr(y);
+            row_shift_left(dst, src, words_per_row, 1);
+            row_shift_right(shifted.data(), src, words_per_row, 1);
+            for (int w = 0; w < words_per_row; ++w) {
+                dst[w] |= shifted[w];
+                if (y > 0) {
+                    dst[w] |= row_ptr(y - 1)[w];
+                }
+                if (y < height_ - 1) {
+                    dst[w] |= row_ptr(y + 1)[w];
+                }
+            }
+            dst[words_per_row - 1] &= last_word_mask;
+        }
+        return res;
+    }
+
+    BitGrid& operator&=(const BitGrid& other)
+    {
+        check_same_size(other, "BitGrid &=: Different sizes");
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] &= other.words[i];
+        }
+        return *this;
+    }
+
+    BitGrid& operator|=(const BitGrid& other)
+    {
+        check_same_size(other, "BitGrid |=: Different sizes");
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] |= other.words[i];
+        }
+        return *this;
+    }
+
+    // Clears all cells which are set in other.
+    BitGrid& and_not(const BitGrid& other)
+    {
+        check_same_size(other, "BitGrid and_not: Different sizes");
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] &= ~other.words[i];
+        }
+        return *this;
+    }
+
+    friend BitGrid operator&(BitGrid a, const BitGrid& b) {
+        return a &= b;
+    }
+    friend BitGrid operator|(BitGrid a, const BitGrid& b) {
+        return a |= b;
+    }
+
+    bool operator==(const BitGrid& other) const = default;
+
+    friend std::ostream& operator<<(std::ostream& os, const BitGrid& g)
+    {
+        for (int y = 0; y < g.height(); ++y) {
+            for (int x = 0; x < g.width(); ++x) {
+                os << (g.test(x, y) ? '#' : '.');
+            }
+            os << "\n";
+        }
+        return os;
+    }
+};
+
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__) && !defined(AOC_BYTE_SCAN_NO_SIMD)
+#define AOC_BYTE_SCAN_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) && !defined(AOC_BYTE_SCAN_NO_SIMD)
+#define AOC_BYTE_SCAN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/*
+    Finds all occurrences of a small set of bytes (e.g. '\n', or the delimiters of a tokeniser) in a buffer.
+    The SIMD kernels compare 32 (AVX2) or 16 (SSE2) bytes against every byte of the set at once,
+    turn the result into a bitmask with movemask and emit one offset per set bit.
+    Without AVX2/SSE2 (e.g. on arm64) it falls back to memchr for a single byte and to a table lookup otherwise.
+    (AVX2 is only used if the compiler targets it, cf. the AOC_NATIVE_ARCH option in CMakeLists.txt.
+    Defining AOC_BYTE_SCAN_NO_SIMD selects the fallback on any target, e.g. to test it, cf. tests/byte-scan-test.cpp.)
+*/
+
+namespace aocio
+{
+
+class ByteSet
+{
+public:
+    static constexpr std::size_t max_size = 8;
+
+private:
+    std::array<char, max_size> bytes_ {};
+    std::size_t size_ = 0;
+    std::array<bool, 256> table_ {};
+
+public:
+    constexpr ByteSet() = default;
+
+    constexpr ByteSet(std::string_view bytes)
+    {
+        for (char b : bytes) {
+            insert(b);
+        }
+    }
+
+    constexpr void insert(char b)
+    {
+        if (contains(b)) {
+            return;
+        }
+        if (size_ == max_size) {
+            throw std::length_error("ByteSet: too many bytes");
+        }
+        bytes_[size_++] = b;
+        table_[static_cast<unsigned char>(b)] = true;
+    }
+
+    constexpr bool contains(char b) const {
+        return table_[static_cast<unsigned char>(b)];
+    }
+
+    constexpr std::size_t size() const {
+        return size_;
+    }
+
+    constexpr char operator[](std::size_t i) const {
+        return bytes_[i];
+    }
+};
+
+// Calls on_match(offset) for every byte of data which is in set, in ascending order.
+template <typename OnMatch>
+inline void for_each_byte_match(std::string_view data, const ByteSet& set, OnMatch&& on_match)
+{
+    const char* const ptr = data.data();
+    const std::size_t n = data.size();
+    std::size_t i = 0;
+
+    if (set.size() == 0) {
+        return;
+    }
+
+#if defined(AOC_BYTE_SCAN_AVX2)
+    __m256i needles[ByteSet::max_size];
+    for (std::size_t k = 0; k < set.size(); ++k) {
+        needles[k] = _mm256_set1_epi8(set[k]);
+    }
+    for (; i + 32 <= n; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i));
+        __m256i eq = _mm256_cmpeq_epi8(block, needles[0]);
+        for (std::size_t k = 1; k < set.size(); ++k) {
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(block, needles[k]));
+        }
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        while (mask) {
+            on_match(i + std::countr_zero(mask));
+            mask &= mask - 1; // Clear the lowest set bit.
+        }
+    }
+#elif defined(AOC_BYTE_SCAN_SSE2)
+    __m128i needles[ByteSet::max_size];
+    for (std::size_t k = 0; k < set.size(); ++k) {
+        needles[k] = _mm_set1_epi8(set[k]);
+    }
+    for (; i + 16 <= n; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+        __m128i eq = _mm_cmpeq_epi8(block, needles[0]);
+        for (std::size_t k = 1; k < set.size(); ++k) {
+            eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, needles[k]));
+        }
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        while (mask) {
+            on_match(i + std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+#else
+    if (set.size() == 1) { // memchr is vectorised by the C library.
+        while (i < n) {
+            const void* found = std::memchr(ptr + i, set[0], n - i);
+            if (!found) {
+                return;
+            }
+            i = static_cast<const char*>(found) - ptr;
+            on_match(i++);
+        }
+        return;
+    }
+#endif
+
+    for (; i < n; ++i) { // Scalar tail (or everything without SIMD).
+        if (set.contains(ptr[i])) {
+            on_match(i);
+        }
+    }
+}
+
+// Writes the offsets of all bytes of data which are in set to offsets (which must have room for all of them), returns their number.
+inline std::size_t find_bytes(std::string_view data, const ByteSet& set, std::size_t* offsets)
+{
+    std::size_t cnt = 0;
+    for_each_byte_match(data, set, [offsets, &cnt](std::size_t offset) { offsets[cnt++] = offset; });
+    return cnt;
+}
+
+// Same as above, but appends to a vector (reserve it to avoid reallocations).
+inline void find_bytes(std::string_view data, const ByteSet& set, std::vector<std::size_t>& offsets)
+{
+    for_each_byte_match(data, set, [&offsets](std::size_t offset) { offsets.push_back(offset); });
+}
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "grid.hpp"
+#include "grid-stencil.hpp"
+#include "vec.hpp"
+
+/*
+    Breadth-first search over the cells of a width * height area (e.g. a grid), from one or more sources at once.
+    The queue is a plain array of width * height linear indices (y * width + x, so the area must have at most INT32_MAX cells),
+    filled front to back: a cell is enqueued when its distance is set, i.e. at most once, so the array never runs full
+    (and is not a ring buffer). A cell counts as visited if its distance is set, so there is no separate visited set.
+    As a consequence, the cells of every layer (i.e. with the same distance) are contiguous in the queue,
+    and are passed to the on_layer callback as one span before the next layer is expanded.
+    The neighbours of a cell are given by a stencil (cf. grid-stencil.hpp), so their loop is unrolled and unchecked away from the edges.
+    Usage:
+        const Grid<int32_t> dist = grid_bfs(grid.width(), grid.height(), sources, [&grid](const Vec2<int>& pos) {return grid[pos] != '#';});
+*/
+
+namespace aocutil
+{
+
+constexpr int32_t bfs_unreachable = -1;
+
+struct NoLayerCallback {
+    void operator()(int32_t, std::span<const int32_t>) const {}
+};
+
+/*
+    The distance of every cell from the nearest source (bfs_unreachable for cells which were not reached).
+    passable(pos) tells whether a (non-source) cell can be entered; cells further than max_dist are not visited.
+    on_layer(dist, cells) is called for every layer with the linear indices of its cells (in the order they were reached),
+    e.g. to count the cells reachable in exactly n steps without any per-step sets.
+*/
+template <typename Stencil = stencil::Von4, typename Passable, typename OnLayer = NoLayerCallback>
+Grid<int32_t> grid_bfs(int width, int height, std::span<const Vec2<int>> sources, Passable&& passable,
+                       int32_t max_dist = std::numeric_limits<int32_t>::max(), OnLayer&& on_layer = {})
+{
+    if (width < 0 || height < 0) {
+        throw std::invalid_argument("grid_bfs: Invalid size");
+    }
+    const std::size_t num_cells = static_cast<std::size_t>(width) * height;
+    if (num_cells > static_cast<std::size_t>(std::numeric_limits<int32_t>::max())) {
+        throw std::length_error("grid_bfs: Too many cells for int32_t indices");
+    }
+    Grid<int32_t> dist_grid {width, height, std::vector<int32_t>(num_cells, bfs_unreachable)};
+    const std::span<int32_t> dist = dist_grid.storage(); // Row-major without a border, i.e. indexed like the queue.
+    std::vector<int32_t> queue(num_cells);
+    std::size_t head = 0, tail = 0;
+
+    for (const Vec2<int>& src : sources) {
+        if (src.x < 0 || src.x >= width || src.y < 0 || src.y >= height) {
+            throw std::out_of_range("grid_bfs: Source not in the area");
+        }
+        const std::size_t idx = src.x + static_cast<std::size_t>(src.y) * width;
+        if (dist[idx] == bfs_unreachable) { // Sources may repeat.
+            dist[idx] = 0;
+            queue[tail++] = static_cast<int32_t>(idx);
+        }
+    }
+
+    for (int32_t layer_dist = 0; head < tail; ++layer_dist) {
+        const std::size_t layer_end = tail;
+        on_layer(layer_dist, std::span<const int32_t> {queue.data() + head, layer_end - head});
+        if (layer_dist == max_dist) {
+            break;
+        }
+        for (; head < layer_end; ++head) {
+            const int32_t idx = queue[head];
+            const Vec2<int> pos {.x = idx % width, .y = idx / width};
+            for_each_neighbor_pos<Stencil>(width, height, pos, [&](const Vec2<int>& adj) {
+                const int32_t adj_idx = adj.x + adj.y * width;
+                if (dist[adj_idx] == bfs_unreachable && passable(adj)) {
+                    dist[adj_idx] = layer_dist + 1;
+                    queue[tail++] = adj_idx;
+                }
+            });
+        }
+    }
+
+    return dist_grid;
+}
+
+// Same as above for a single source.
+template <typename Stencil = stencil::Von4, typename Passable, typename OnLayer = NoLayerCallback>
+Grid<int32_t> grid_bfs(int width, int height, const Vec2<int>& source, Passable&& passable,
+                       int32_t max_dist = std::numeric_limits<int32_t>::max(), OnLayer&& on_layer = {})
+{
+    return grid_bfs<Stencil>(width, height, std::span<const Vec2<int>> {&source, 1}, std::forward<Passable>(passable), max_dist, std::forward<OnLayer>(on_layer));
+}
+
+}
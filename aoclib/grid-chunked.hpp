@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include "vec.hpp"
+
+/*
+    Sparse grid over (practically) unbounded 64-bit coordinates: the cells are stored in dense square chunks of
+    chunk_size * chunk_size cells (64 * 64 by default), which are allocated on the first write to one of their cells
+    and kept in a hash map keyed by chunk coordinates. Cells of chunks which were never written read as the default value,
+    so memory scales with the touched area rather than with the bounding box (e.g. a path around millions of cells).
+    The last accessed chunk is cached, as accesses tend to be close to each other; that makes even const reads
+    not thread-safe (use one ChunkedGrid per thread).
+    for_each_chunk and for_each_cell only visit the populated chunks (in no particular order).
+*/
+
+namespace aocutil
+{
+
+template <typename T, int chunk_bits = 6>
+class ChunkedGrid
+{
+public:
+    static constexpr int64_t chunk_size = int64_t{1} << chunk_bits;
+
+private:
+    static constexpr int64_t chunk_mask = chunk_size - 1;
+
+    struct Chunk {
+        std::array<T, chunk_size * chunk_size> cells;
+    };
+
+    std::unordered_map<Vec2<int64_t>, std::unique_ptr<Chunk>> chunks;
+    T default_value {};
+    mutable Vec2<int64_t> cached_key {};
+    mutable Chunk* cached_chunk = nullptr;
+
+    // The arithmetic shift rounds down, so e.g. x = -1 is in the chunk left of x = 0.
+    static Vec2<int64_t> chunk_key(const Vec2<int64_t>& pos) {
+        return Vec2<int64_t>{.x = pos.x >> chunk_bits, .y = pos.y >> chunk_bits};
+    }
+
+    static std::size_t cell_idx(const Vec2<int64_t>& pos) {
+        return static_cast<std::size_t>((pos.x & chunk_mask) + (pos.y & chunk_mask) * chunk_size);
+    }
+
+    // nullptr if the chunk of pos was never written.
+    Chunk* find_chunk(const Vec2<int64_t>& pos) const
+    {
+        const Vec2<int64_t> key = chunk_key(pos);
+        if (cached_chunk && key == cached_key) {
+            return cached_chunk;
+        }
+        auto found = chunks.find(key);
+        if (found == chunks.end()) {
+            return nullptr;
+        }
+        cached_key = key;
+        cached_chunk = found->second.get();
+        return cached_chunk;
+    }
+
+    Chunk& find_or_add_chunk(const Vec2<int64_t>& pos)
+    {
+        if (Chunk* chunk = find_chunk(pos)) {
+            return *chunk;
+        }
+        std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+        chunk->cells.fill(default_value);
+        cached_key = chunk_key(pos);
+        cached_chunk = chunk.get();
+        chunks.emplace(cached_key, std::move(chunk));
+        return *cached_chunk;
+    }
+
+public:
+    ChunkedGrid() = default;
+
+    explicit ChunkedGrid(const T& default_val) : default_value{default_val} {}
+
+    // The chunks themselves don't move, so the cache stays valid in the destination; the source is left empty.
+    ChunkedGrid(ChunkedGrid&& other) noexcept
+        : chunks{std::move(other.chunks)}, default_value{std::move(other.default_value)}, cached_key{other.cached_key}, cached_chunk{other.cached_chunk}
+    {
+        other.chunks.clear();
+        other.cached_chunk = nullptr;
+    }
+
+    ChunkedGrid& operator=(ChunkedGrid&& other) noexcept
+    {
+        if (this != &other) {
+            chunks = std::move(other.chunks);
+            default_value = std::move(other.default_value);
+            cached_key = other.cached_key;
+            cached_chunk = other.cached_chunk;
+            other.chunks.clear();
+            other.cached_chunk = nullptr;
+        }
+        return *this;
+    }
+
+    const T& get(const Vec2<int64_t>& pos) const
+    {
+        const Chunk* chunk = find_chunk(pos);
+        return chunk ? chunk->cells[cell_idx(pos)] : default_value;
+    }
+
+    // A reference to the cell for writing (allocates its chunk if necessary).
+    T& operator[](const Vec2<int64_t>& pos) {
+        return find_or_add_chunk(pos).cells[cell_idx(pos)];
+    }
+
+    void set(const Vec2<int64_t>& pos, const T& value) {
+        (*this)[pos] = value;
+    }
+
+    std::size_t num_chunks() const {
+        return chunks.size();
+    }
+
+    void clear()
+    {
+        chunks.clear();
+        cached_chunk = nullptr;
+    }
+
+    // f(origin, cells) for every populated chunk; origin is the position of its top-left cell, cells are in row-major order.
+    template <typename Fn>
+    void for_each_chunk(Fn&& f) const
+    {
+        for (const auto& [key, chunk] : chunks) {
+            f(Vec2<int64_t>{.x = key.x * chunk_size, .y = key.y * chunk_size}, std::span<const T> {chunk->cells});
+        }
+    }
+
+    // f(pos, elem) for every cell of the populated chunks (including cells which still have the default value).
+    template <typename Fn>
+    void for_each_cell(Fn&& f) const
+    {
+        for_each_chunk([&f](const Vec2<int64_t>& origin, std::span<const T> cells) {
+            for (int64_t y = 0; y < chunk_size; ++y) {
+                for (int64_t x = 0; x < chunk_size; ++x) {
+                    f(Vec2<int64_t>{.x = origin.x + x, .y = origin.y + y}, cells[x + y * chunk_size]);
+                }
+            }
+        });
+    }
+
+    // The number of cells for which pred(elem) is true (cells of chunks which were never written are not counted).
+    template <typename Pred>
+    int64_t count_if(Pred&& pred) const
+    {
+        int64_t cnt = 0;
+        for_each_chunk([&pred, &cnt](const Vec2<int64_t>&, std::span<const T> cells) {
+            cnt += std::count_if(cells.begin(), cells.end(), pred);
+        });
+        return cnt;
+    }
+};
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "vec.hpp"
+
+/*
+    Scratch grids for algorithms which need a fresh grid per run (e.g. one run per start position).
+    An EpochGrid stamps every written cell with the current epoch; cells with an older stamp read as the default value,
+    so reset() is O(1) (it just starts a new epoch) instead of re-initialising every cell.
+    A ScratchGridPool hands out such grids (reset, and of the requested size) and takes them back when the lease ends,
+    so repeated runs over grids of the same size don't allocate after the first one.
+    Not thread-safe: use one pool per thread.
+*/
+
+namespace aocutil
+{
+
+template <typename T>
+class EpochGrid
+{
+    std::vector<T> values;
+    std::vector<uint32_t> stamps; // The epoch in which a cell was last written.
+    uint32_t epoch = 1;
+    int width_ = 0, height_ = 0;
+    T default_value {};
+
+    std::size_t idx(int x, int y) const
+    {
+        assert(pos_on_grid(x, y));
+        return x + static_cast<std::size_t>(y) * width_;
+    }
+
+public:
+    EpochGrid(int width, int height, const T& default_val = T {}) : width_{width}, height_{height}, default_value{default_val}
+    {
+        if (width < 0 || height < 0) {
+            throw std::invalid_argument("EpochGrid::EpochGrid: Invalid size");
+        }
+        values.resize(static_cast<std::size_t>(width) * height);
+        stamps.resize(values.size(), 0);
+    }
+
+    int width() const {
+        return width_;
+    }
+    int height() const {
+        return height_;
+    }
+
+    bool pos_on_grid(int x, int y) const {
+        return x >= 0 && x < width_ && y >= 0 && y < height_;
+    }
+    bool pos_on_grid(const Vec2<int>& pos) const {
+        return pos_on_grid(pos.x, pos.y);
+    }
+
+    // All cells read as the default value again.
+    void reset()
+    {
+        if (++epoch == 0) { // Wrapped around (after 2^32 resets), so old stamps could match again.
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+    }
+    void reset(const T& default_val)
+    {
+        reset();
+        default_value = default_val;
+    }
+
+    // Whether the cell was written since the last reset.
+    bool touched(const Vec2<int>& pos) const {
+        return stamps[idx(pos.x, pos.y)] == epoch;
+    }
+
+    const T& get(const Vec2<int>& pos) const
+    {
+        const std::size_t i = idx(pos.x, pos.y);
+        return stamps[i] == epoch ? values[i] : default_value;
+    }
+
+    // A reference to the cell for writing (the default value if it was not written since the last reset).
+    T& touch(const Vec2<int>& pos)
+    {
+        const std::size_t i = idx(pos.x, pos.y);
+        if (stamps[i] != epoch) {
+            stamps[i] = epoch;
+            values[i] = default_value;
+        }
+        return values[i];
+    }
+
+    void set(const Vec2<int>& pos, const T& value) {
+        touch(pos) = value;
+    }
+};
+
+template <typename T>
+class ScratchGridPool
+{
+    std::vector<std::unique_ptr<EpochGrid<T>>> free_grids;
+
+public:
+    // An EpochGrid which goes back to its pool at the end of the lease's lifetime.
+    class Lease
+    {
+        ScratchGridPool* pool = nullptr;
+        std::unique_ptr<EpochGrid<T>> grid;
+
+    public:
+        Lease(ScratchGridPool& parent, std::unique_ptr<EpochGrid<T>> leased) : pool{&parent}, grid{std::move(leased)} {}
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease(Lease&& other) noexcept = default;
+        Lease& operator=(Lease&& other) = delete;
+
+        ~Lease()
+        {
+            if (grid) {
+                pool->free_grids.push_back(std::move(grid));
+            }
+        }
+
+        EpochGrid<T>& operator*() const {
+            return *grid;
+        }
+        EpochGrid<T>* operator->() const {
+            return grid.get();
+        }
+    };
+
+    // A reset grid of the given size (all cells read as default_value), reusing a free grid of that size if there is one.
+    Lease acquire(int width, int height, const T& default_value = T {})
+    {
+        auto found = std::find_if(free_grids.begin(), free_grids.end(), [width, height](const auto& g) {
+            return g->width() == width && g->height() == height;
+        });
+        if (found == free_grids.end()) {
+            return Lease {*this, std::make_unique<EpochGrid<T>>(width, height, default_value)};
+        }
+        std::unique_ptr<EpochGrid<T>> grid = std::move(*found);
+        free_grids.erase(found);
+        grid->reset(default_value);
+        return Lease {*this, std::move(grid)};
+    }
+};
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "grid.hpp"
+#include "vec.hpp"
+
+/*
+    Structure-of-arrays grid: a cell consists of one value per field, but every field is stored in its own plane (a Grid of that field),
+    so a loop which only reads one field only pulls that plane into the cache (instead of whole cells, cf. Grid<SomeStruct>).
+    Fields are addressed by their index: grid.plane<1>()[pos], grid.get<1>(pos); if all fields have the same type
+    (cf. UniformSoAGrid), also with an index known only at runtime: grid.plane(i)[pos].
+    (Avoid bool fields, as Grid<bool> is backed by std::vector<bool>; use char or uint8_t instead.)
+*/
+
+namespace aocutil
+{
+
+template <typename... Fields>
+class SoAGrid
+{
+    static_assert(sizeof...(Fields) > 0, "SoAGrid: No fields");
+
+    using First = std::tuple_element_t<0, std::tuple<Fields...>>;
+    static constexpr bool uniform = (std::is_same_v<First, Fields> && ...);
+    // Uniform planes live in an array, so they can be indexed at runtime; std::get works on both.
+    using Planes = std::conditional_t<uniform, std::array<Grid<First>, sizeof...(Fields)>, std::tuple<Grid<Fields>...>>;
+
+    Planes planes;
+    int width_ = 0, height_ = 0;
+
+    template <typename T>
+    static Grid<T> filled_plane(int width, int height, const T& value) {
+        return Grid<T> {width, height, std::vector<T>(static_cast<std::size_t>(width) * height, value)};
+    }
+
+public:
+    template <std::size_t I>
+    using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    static constexpr std::size_t num_fields = sizeof...(Fields);
+
+    SoAGrid() = default;
+
+    // Every cell starts as (init...).
+    SoAGrid(int width, int height, const Fields&... init) : planes{filled_plane(width, height, init)...}, width_{width}, height_{height}
+    {
+        if (width < 0 || height < 0) {
+            throw std::invalid_argument("SoAGrid::SoAGrid: Invalid size");
+        }
+    }
+
+    // Every cell starts as (init, init, ...).
+    SoAGrid(int width, int height, const First& init) requires (uniform && sizeof...(Fields) > 1)
+        : SoAGrid(width, height, std::make_index_sequence<sizeof...(Fields)> {}, init) {}
+
+private:
+    template <std::size_t... Is>
+    SoAGrid(int width, int height, std::index_sequence<Is...>, const First& init)
+        : SoAGrid(width, height, (static_cast<void>(Is), init)...) {}
+
+public:
+    int width() const {
+        return width_;
+    }
+    int height() const {
+        return height_;
+    }
+
+    bool pos_on_grid(int x, int y) const {
+        return x >= 0 && x < width_ && y >= 0 && y < height_;
+    }
+    bool pos_on_grid(const Vec2<int>& pos) const {
+        return pos_on_grid(pos.x, pos.y);
+    }
+
+    template <std::size_t I>
+    Grid<Field<I>>& plane() {
+        return std::get<I>(planes);
+    }
+    template <std::size_t I>
+    const Grid<Field<I>>& plane() const {
+        return std::get<I>(planes);
+    }
+
+    Grid<First>& plane(std::size_t i) requires uniform
+    {
+        assert(i < num_fields);
+        return planes[i];
+    }
+    const Grid<First>& plane(std::size_t i) const requires uniform
+    {
+        assert(i < num_fields);
+        return planes[i];
+    }
+
+    // Unchecked (cf. Grid::operator[]).
+    template <std::size_t I>
+    Field<I>& get(const Vec2<int>& pos) {
+        return plane<I>()[pos];
+    }
+    template <std::size_t I>
+    const Field<I>& get(const Vec2<int>& pos) const {
+        return plane<I>()[pos];
+    }
+
+    // All fields of a cell (gathered from the planes).
+    std::tuple<Fields...> cell(const Vec2<int>& pos) const
+    {
+        if (!pos_on_grid(pos)) {
+            throw std::out_of_range("SoAGrid cell: invalid position");
+        }
+        return std::apply([&pos](const auto&... p) {return std::tuple<Fields...> {p[pos]...};}, planes);
+    }
+
+    void set_cell(const Vec2<int>& pos, const Fields&... values)
+    {
+        if (!pos_on_grid(pos)) {
+            throw std::out_of_range("SoAGrid set_cell: invalid position");
+        }
+        std::apply([&pos, &values...](auto&... p) {((p[pos] = values), ...);}, planes);
+    }
+};
+
+namespace detail
+{
+template <typename T, typename Seq>
+struct UniformSoAGridImpl;
+
+template <typename T, std::size_t... Is>
+struct UniformSoAGridImpl<T, std::index_sequence<Is...>> {
+    using type = SoAGrid<std::conditional_t<true, T, std::integral_constant<std::size_t, Is>>...>;
+};
+}
+
+// N planes of type T, e.g. one plane per search state of a cell.
+template <typename T, std::size_t N>
+using UniformSoAGrid = typename detail::UniformSoAGridImpl<T, std::make_index_sequence<N>>::type;
+
+}
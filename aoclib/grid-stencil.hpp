@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include "vec.hpp"
+
+/*
+    Neighbourhoods (stencils) of a cell with their offsets known at compile time, and loops over the neighbours of a cell
+    which are unrolled for the given stencil: for cells at least radius away from every edge (i.e. most cells of a grid),
+    all neighbours are on the grid, so they are visited without any bounds checks; only the cells near the edges check every neighbour.
+    Usage:
+        for_each_neighbor<stencil::Moore8>(grid, pos, [&](const Vec2<int>& adj, char c) {...});
+        for_each_neighbor<stencil::Custom<Vec2<int>{.x = 2, .y = 0}, Vec2<int>{.x = -2, .y = 0}>>(grid, pos, ...);
+*/
+
+namespace aocutil
+{
+
+namespace stencil
+{
+// The neighbours of a cell: Von4 (left, right, top and bottom), Moore8 (with the diagonals), Custom (any offsets).
+struct Von4 {
+    static constexpr std::array<Vec2<int>, 4> offsets = all_dirs_vec2<int>();
+};
+struct Moore8 {
+    static constexpr std::array<Vec2<int>, 8> offsets {{
+        {.x = -1, .y = -1}, {.x = 0, .y = -1}, {.x = 1, .y = -1},
+        {.x = -1, .y = 0}, {.x = 1, .y = 0},
+        {.x = -1, .y = 1}, {.x = 0, .y = 1}, {.x = 1, .y = 1}
+    }};
+};
+template <Vec2<int>... Offsets>
+struct Custom {
+    static constexpr std::array<Vec2<int>, sizeof...(Offsets)> offsets {Offsets...};
+};
+
+// The largest distance of a neighbour from the cell along either axis.
+template <typename Stencil>
+constexpr int radius = [] {
+    int r = 0;
+    for (const Vec2<int>& offset : Stencil::offsets) {
+        r = std::max({r, offset.x, -offset.x, offset.y, -offset.y});
+    }
+    return r;
+}();
+}
+
+namespace detail
+{
+template <typename Stencil, typename Fn, std::size_t... Is>
+void for_each_offset_unchecked(const Vec2<int>& pos, Fn& f, std::index_sequence<Is...>)
+{
+    (f(Vec2<int>{.x = pos.x + Stencil::offsets[Is].x, .y = pos.y + Stencil::offsets[Is].y}), ...);
+}
+
+template <typename Stencil, typename Fn, std::size_t... Is>
+void for_each_offset_checked(int width, int height, const Vec2<int>& pos, Fn& f, std::index_sequence<Is...>)
+{
+    auto visit = [width, height, &f](const Vec2<int>& adj) {
+        if (adj.x >= 0 && adj.x < width && adj.y >= 0 && adj.y < height) {
+            f(adj);
+        }
+    };
+    (visit(Vec2<int>{.x = pos.x + Stencil::offsets[Is].x, .y = pos.y + Stencil::offsets[Is].y}), ...);
+}
+}
+
+// f(adj) for every neighbour adj of pos (in the order of Stencil::offsets) which lies in the width * height area.
+template <typename Stencil, typename Fn>
+void for_each_neighbor_pos(int width, int height, const Vec2<int>& pos, Fn&& f)
+{
+    constexpr int r = stencil::radius<Stencil>;
+    constexpr auto seq = std::make_index_sequence<Stencil::offsets.size()> {};
+    if (pos.x >= r && pos.x < width - r && pos.y >= r && pos.y < height - r) {
+        detail::for_each_offset_unchecked<Stencil>(pos, f, seq);
+    } else {
+        detail::for_each_offset_checked<Stencil>(width, height, pos, f, seq);
+    }
+}
+
+// f(adj, grid[adj]) for every neighbour adj of pos on the grid (a Grid, GridView etc.).
+template <typename Stencil, typename GridT, typename Fn>
+void for_each_neighbor(GridT& grid, const Vec2<int>& pos, Fn&& f)
+{
+    for_each_neighbor_pos<Stencil>(grid.width(), grid.height(), pos, [&grid, &f](const Vec2<int>& adj) {
+        f(adj, grid[adj]);
+    });
+}
+
+}
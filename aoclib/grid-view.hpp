@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include "grid.hpp"
+#include "vec.hpp"
+
+namespace aocutil
+{
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+/*
+    Floor division and (non-negative) remainder by a fixed divisor, e.g. (-1, 131) -> quotient -1, remainder 130.
+    For powers of two, these are a shift and a mask; otherwise, the quotient is computed by multiplying with a
+    precomputed 128-bit reciprocal of the divisor, which is exact for all 64-bit numerators as the divisor has at most 32 bits.
+    cf. https://arxiv.org/abs/1902.01961 (Lemire et al., Faster Remainder by Direct Computation; last retrieved 2024-07-08)
+*/
+class FastDivisor
+{
+    int64_t divisor_ = 1;
+    int shift = 0; // log2(divisor) if it is a power of two, -1 otherwise.
+#if defined(__SIZEOF_INT128__)
+    uint128_t reciprocal = 0;
+#endif
+
+    uint64_t unsigned_div(uint64_t x) const
+    {
+#if defined(__SIZEOF_INT128__)
+        const uint64_t recip_lo = static_cast<uint64_t>(reciprocal), recip_hi = static_cast<uint64_t>(reciprocal >> 64);
+        const uint128_t lo = static_cast<uint128_t>(x) * recip_lo;
+        const uint128_t hi = static_cast<uint128_t>(x) * recip_hi + (lo >> 64);
+        return static_cast<uint64_t>(hi >> 64);
+#else
+        return x / static_cast<uint64_t>(divisor_);
+#endif
+    }
+
+public:
+    struct DivMod {
+        int64_t quot, rem;
+    };
+
+    FastDivisor() = default;
+
+    explicit FastDivisor(int64_t divisor) : divisor_{divisor}
+    {
+        if (divisor <= 0 || divisor > UINT32_MAX) {
+            throw std::invalid_argument("FastDivisor: Divisor must be in [1, 2^32)");
+        }
+        shift = std::has_single_bit(static_cast<uint64_t>(divisor)) ? std::countr_zero(static_cast<uint64_t>(divisor)) : -1;
+#if defined(__SIZEOF_INT128__)
+        reciprocal = ~static_cast<uint128_t>(0) / static_cast<uint64_t>(divisor) + 1;
+#endif
+    }
+
+    int64_t divisor() const {
+        return divisor_;
+    }
+
+    DivMod divmod(int64_t x) const
+    {
+        if (shift >= 0) {
+            return DivMod {.quot = x >> shift, .rem = x & (divisor_ - 1)}; // The shift of a negative x rounds down, too.
+        }
+        int64_t quot;
+        if (x >= 0) {
+            quot = unsigned_div(static_cast<uint64_t>(x));
+        } else { // floor(x / d) = -ceil(-x / d) = -((-x - 1) / d) - 1
+            quot = -static_cast<int64_t>(unsigned_div(static_cast<uint64_t>(-(x + 1)))) - 1;
+        }
+        // In uint64_t, as quot * divisor_ overflows for x near INT64_MIN (and the remainder is exact modulo 2^64 anyway). 
+        const uint64_t rem = static_cast<uint64_t>(x) - static_cast<uint64_t>(quot) * static_cast<uint64_t>(divisor_);
+        return DivMod {.quot = quot, .rem = static_cast<int64_t>(rem)};
+    }
+};
+
+/*
+    Non-owning view of a grid whose rows are stride elements apart in memory, e.g. GridView<const char> over the lines of 
+    a text buffer (stride width + 1 to skip the '\n', cf. text_grid_view) or over the rows of a Grid. 
+    The viewed elements must outlive the view; to_grid() makes an owning copy (e.g. to modify it, or to add a border). 
+*/
+template <typename ElemType>
+class GridView
+{
+    ElemType* data_ = nullptr; 
+    int width_ = 0, height_ = 0; 
+    std::ptrdiff_t stride_ = 0; 
+
+public:
+    using value_type = std::remove_const_t<ElemType>; 
+
+    GridView() = default; 
+
+    GridView(ElemType* first, int width, int height, std::ptrdiff_t stride) : data_{first}, width_{width}, height_{height}, stride_{stride}
+    {
+        if (width < 0 || height < 0 || stride < width) {
+            throw std::invalid_argument("GridView: Invalid size or stride");
+        }
+    }
+
+    // Of the cells of grid (without its border). 
+    template <typename GridElem>
+    explicit GridView(Grid<GridElem>& grid) requires std::is_same_v<std::remove_const_t<ElemType>, GridElem> 
+        : GridView(grid.width() && grid.height() ? &grid.storage()[grid.index(0, 0)] : nullptr, grid.width(), grid.height(), grid.stride()) {}
+    template <typename GridElem>
+    explicit GridView(const Grid<GridElem>& grid) requires (std::is_const_v<ElemType> && std::is_same_v<std::remove_const_t<ElemType>, GridElem>)
+        : GridView(grid.width() && grid.height() ? &grid.storage()[grid.index(0, 0)] : nullptr, grid.width(), grid.height(), grid.stride()) {}
+
+    int width() const {
+        return width_;
+    }
+    int height() const {
+        return height_;
+    }
+    std::ptrdiff_t stride() const {
+        return stride_;
+    }
+
+    bool pos_on_grid(int x, int y) const {
+        return x >= 0 && x < width_ && y >= 0 && y < height_;
+    }
+    bool pos_on_grid(const Vec2<int>& pos) const {
+        return pos_on_grid(pos.x, pos.y);
+    }
+
+    ElemType& operator[](const Vec2<int>& pos) const
+    {
+        assert(pos_on_grid(pos)); 
+        return data_[pos.x + pos.y * stride_]; 
+    }
+
+    ElemType& at(int x, int y) const
+    {
+        if (!pos_on_grid(x, y)) {
+            throw std::out_of_range("GridView at: invalid position");
+        }
+        return data_[x + y * stride_]; 
+    }
+    ElemType& at(const Vec2<int>& pos) const {
+        return at(pos.x, pos.y);
+    }
+
+    std::optional<value_type> try_get(int x, int y) const 
+    {
+        if (!pos_on_grid(x, y)) {
+            return {};
+        }
+        return data_[x + y * stride_]; 
+    }
+    std::optional<value_type> try_get(const Vec2<int>& pos) const {
+        return try_get(pos.x, pos.y);
+    }
+
+    std::span<ElemType> row(int y) const
+    {
+        assert(y >= 0 && y < height_);
+        return std::span<ElemType> {data_ + y * stride_, static_cast<std::size_t>(width_)};
+    }
+
+    // cf. Grid::index_symbols
+    SymbolIndex<value_type> index_symbols(std::span<const value_type> symbols) const
+    {
+        std::vector<detail::SymbolHit> hits; 
+        detail::find_row_symbols(height_, [this](int y) {return std::span<const value_type> {row(y)};}, symbols, hits); 
+        return detail::make_symbol_index(symbols, hits); 
+    }
+    SymbolIndex<value_type> index_symbols(std::initializer_list<value_type> symbols) const {
+        return index_symbols(std::span<const value_type> {symbols.begin(), symbols.size()}); 
+    }
+
+    Grid<value_type> to_grid() const {
+        return Grid<value_type> {width_, height_, data_, stride_}; 
+    }
+};
+
+/*
+    The grid in the lines of text, without copying it: all non-blank lines must have the same width (and must not be separated 
+    by blank lines); blank lines at the start and end are skipped. (Same line semantics as aocio::file_getlines, i.e. a '\r' 
+    before the '\n' would be a cell.)
+*/
+inline GridView<const char> text_grid_view(std::string_view text)
+{
+    auto is_blank = [](std::string_view line) {return line.find_first_not_of(" \t\r") == std::string_view::npos;}; 
+    const char* first = nullptr; 
+    int width = 0, height = 0; 
+    bool grid_ended = false; 
+    std::size_t line_begin = 0; 
+    while (line_begin < text.size()) {
+        const std::size_t line_end = std::min(text.find('\n', line_begin), text.size()); 
+        const std::string_view line = text.substr(line_begin, line_end - line_begin); 
+        line_begin = line_end + 1; 
+        if (is_blank(line)) {
+            grid_ended = first != nullptr; 
+            continue; 
+        }
+        if (grid_ended) {
+            throw std::invalid_argument("text_grid_view: Blank line within the grid"); 
+        }
+        if (!first) {
+            first = line.data(); 
+            width = std::ssize(line); 
+        } else if (std::ssize(line) != width) {
+            throw std::invalid_argument("text_grid_view: Lines of different width"); 
+        }
+        ++height; 
+    }
+    return GridView<const char> {first, width, height, width + 1}; 
+}
+
+/*
+    Read-only view of a grid which is repeated infinitely in every direction (like the garden of day 21, part 2), without copying it.
+    Any position maps to a position on the grid and to the tile it is in, e.g. for a 10x10 grid, (-1, 25) is (9, 5) on tile (-1, 2).
+*/
+template <typename ElemType, typename Layout = RowMajor>
+class WrappingGridView
+{
+    const Grid<ElemType, Layout>* grid_ = nullptr;
+    FastDivisor div_x, div_y;
+
+public:
+    struct Wrapped {
+        Vec2<int> pos; // On the grid.
+        Vec2<int64_t> tile;
+    };
+
+    explicit WrappingGridView(const Grid<ElemType, Layout>& grid) : grid_{&grid}
+    {
+        if (grid.width() <= 0 || grid.height() <= 0) {
+            throw std::invalid_argument("WrappingGridView: Empty grid");
+        }
+        div_x = FastDivisor {grid.width()};
+        div_y = FastDivisor {grid.height()};
+    }
+
+    const Grid<ElemType, Layout>& grid() const {
+        return *grid_;
+    }
+
+    Wrapped wrap(const Vec2<int64_t>& pos) const
+    {
+        const FastDivisor::DivMod x = div_x.divmod(pos.x), y = div_y.divmod(pos.y);
+        return Wrapped {.pos = Vec2<int>{.x = static_cast<int>(x.rem), .y = static_cast<int>(y.rem)}, .tile = Vec2<int64_t>{.x = x.quot, .y = y.quot}};
+    }
+
+    Vec2<int64_t> tile(const Vec2<int64_t>& pos) const {
+        return wrap(pos).tile;
+    }
+
+    const ElemType& operator[](const Vec2<int64_t>& pos) const {
+        return (*grid_)[wrap(pos).pos];
+    }
+};
+
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+#include "grid.hpp"
+#include "vec.hpp"
+
+/*
+    A Grid with a Zobrist hash of its contents: the key is the XOR of one pseudo-random 64-bit key per (cell, element),
+    so set() updates it in O(1) (XOR out the key of the old element, XOR in the key of the new one) instead of rehashing the grid.
+    cf. https://en.wikipedia.org/wiki/Zobrist_hashing (last retrieved 2024-07-10)
+    The keys of the cells are derived from their positions in the original orientation of the grid, so rotating the grid
+    (which only moves the cells) does not change the key, e.g. the key after a full spin (four rotations) is comparable to the key before.
+    As with any hash, different grids can have the same key (with a probability of about 2^-64 per pair).
+*/
+
+namespace aocutil
+{
+
+template <typename ElemType>
+class ZobristGrid
+{
+    Grid<ElemType> grid_;
+    int orig_width = 0;
+    int rotation = 0; // The number of clockwise rotations (mod 4) since construction.
+    uint64_t key_ = 0;
+
+    // cf. https://prng.di.unimi.it/splitmix64.c (last retrieved 2024-07-10)
+    static constexpr uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    // The position of (x, y) in the original orientation.
+    Vec2<int> original_pos(int x, int y) const
+    {
+        int w = grid_.width(), h = grid_.height();
+        for (int i = 0; i < rotation; ++i) { // Undo one clockwise rotation: (x, y) was (y, w - 1 - x).
+            const int prev_x = y;
+            y = w - 1 - x;
+            x = prev_x;
+            std::swap(w, h);
+        }
+        return Vec2<int>{.x = x, .y = y};
+    }
+
+    uint64_t cell_key(int x, int y, const ElemType& elem) const
+    {
+        const Vec2<int> orig = original_pos(x, y);
+        const uint64_t cell = static_cast<uint64_t>(orig.x) + static_cast<uint64_t>(orig.y) * orig_width;
+        return mix(mix(cell + 0x9e3779b97f4a7c15) + std::hash<ElemType>{}(elem));
+    }
+
+    void recompute_key()
+    {
+        key_ = 0;
+        for (int y = 0; y < grid_.height(); ++y) {
+            const std::span<const ElemType> row = grid_.row(y);
+            for (int x = 0; x < grid_.width(); ++x) {
+                key_ ^= cell_key(x, y, row[x]);
+            }
+        }
+    }
+
+public:
+    ZobristGrid() = default;
+
+    explicit ZobristGrid(Grid<ElemType> grid) : grid_{std::move(grid)}, orig_width{grid_.width()}
+    {
+        recompute_key();
+    }
+
+    const Grid<ElemType>& grid() const {
+        return grid_;
+    }
+
+    uint64_t key() const {
+        return key_;
+    }
+
+    int width() const {
+        return grid_.width();
+    }
+    int height() const {
+        return grid_.height();
+    }
+
+    bool pos_on_grid(int x, int y) const {
+        return grid_.pos_on_grid(x, y);
+    }
+
+    ElemType get(int x, int y) const {
+        return grid_.get(x, y);
+    }
+
+    std::span<const ElemType> row(int y) const {
+        return grid_.row(y);
+    }
+
+    void set(int x, int y, const ElemType& e)
+    {
+        const ElemType old = grid_.get(x, y); // Throws for invalid positions.
+        if (old == e) {
+            return;
+        }
+        key_ ^= cell_key(x, y, old) ^ cell_key(x, y, e);
+        grid_.set(x, y, e);
+    }
+    void set(const Vec2<int>& pos, const ElemType& e) {
+        set(pos.x, pos.y, e);
+    }
+
+    void rotate_cw()
+    {
+        grid_.rotate_cw();
+        rotation = (rotation + 1) % 4;
+    }
+
+    void rotate_ccw()
+    {
+        grid_.rotate_ccw();
+        rotation = (rotation + 3) % 4;
+    }
+};
+
+}
@@ -1,19 +1,131 @@
 #pragma once
 
 #include <vector>
+#include <array>
+#include <initializer_list>
 #include <limits>
 #include <cassert>
 #include <optional>
+#include <span>
+#include <bit>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include "byte-scan.hpp"
 #include "vec.hpp"
 
 namespace aocutil
 {
 
-template<typename ElemType>
+/*
+    Storage layouts of a Grid: index(x, y) maps a position to the index of its element in the storage, size() is the size of the storage.
+    RowMajor (the default) stores the rows one after another (optionally with a border, cf. Grid). 
+    Tiled stores square tiles of tile_size * tile_size elements one after another (the tiles in row-major order), 
+    and Morton orders the elements along the Z-order curve (interleaved bits of x and y), 
+    so both columns and rows (and neighbours in general) are mostly close to each other in memory. 
+    cf. https://en.wikipedia.org/wiki/Z-order_curve (last retrieved 2024-07-05)
+    Only RowMajor has contiguous rows (row(), stride(), offset() and pointer iterators); 
+    the other layouts pad the storage to whole tiles (resp. whole Morton blocks, cf. Morton). 
+*/
+struct RowMajor 
+{
+    static constexpr bool contiguous_rows = true; 
+
+    int stride = 0, border = 0; 
+    std::size_t size_ = 0; 
+
+    RowMajor() = default; 
+    RowMajor(int width, int height, int border_size = 0) : stride{width + 2 * border_size}, border{border_size}, 
+                                                           size_{static_cast<std::size_t>(width + 2 * border_size) * (height + 2 * border_size)} {}
+
+    std::size_t size() const {
+        return size_; 
+    }
+    std::size_t index(int x, int y) const {
+        return (x + border) + static_cast<std::ptrdiff_t>(y + border) * stride; 
+    }
+};
+
+template <int tile_size = 32>
+struct Tiled 
+{
+    static_assert(tile_size > 0 && std::has_single_bit(static_cast<unsigned>(tile_size)), "Tiled: tile_size must be a power of two"); 
+    static constexpr bool contiguous_rows = false; 
+
+    int tiles_per_row = 0; 
+    std::size_t size_ = 0; 
+
+    Tiled() = default; 
+    Tiled(int width, int height) : tiles_per_row{(width + tile_size - 1) / tile_size}, 
+                                   size_{static_cast<std::size_t>(tiles_per_row) * ((height + tile_size - 1) / tile_size) * tile_size * tile_size} {}
+
+    std::size_t size() const {
+        return size_; 
+    }
+    std::size_t index(int x, int y) const 
+    {
+        const unsigned ux = x, uy = y; 
+        const std::size_t tile = static_cast<std::size_t>(uy / tile_size) * tiles_per_row + ux / tile_size; 
+        return tile * (tile_size * tile_size) + (uy % tile_size) * tile_size + ux % tile_size; 
+    }
+};
+
+/*
+    Z-order within square blocks whose side is the shorter side of the grid rounded up to a power of two, 
+    and the blocks one after another along the longer side: interleaving all bits of x and y would need a storage of 
+    about the square of the longer side (e.g. 2^40 elements for a 2 * 1000000 grid), with blocks it is at most 
+    about four times the number of elements (and the plain Z-order curve for square grids with a power-of-two side). 
+*/
+struct Morton 
+{
+    static constexpr bool contiguous_rows = false; 
+
+    int block_bits = 0; // The side of a block is 2^block_bits. 
+    std::size_t size_ = 0; 
+
+    // Puts the bits of v into the even bits of the result. 
+    static constexpr uint64_t spread_bits(uint32_t v) 
+    {
+        uint64_t res = v; 
+        res = (res | (res << 16)) & 0x0000ffff0000ffff; 
+        res = (res | (res << 8)) & 0x00ff00ff00ff00ff; 
+        res = (res | (res << 4)) & 0x0f0f0f0f0f0f0f0f; 
+        res = (res | (res << 2)) & 0x3333333333333333; 
+        res = (res | (res << 1)) & 0x5555555555555555; 
+        return res; 
+    }
+
+    Morton() = default; 
+    Morton(int width, int height) 
+    {
+        if (width <= 0 || height <= 0) {
+            return; 
+        }
+        block_bits = std::bit_width(static_cast<unsigned>(std::min(width, height)) - 1); 
+        const std::size_t side = std::size_t{1} << block_bits; 
+        size_ = (static_cast<std::size_t>(std::max(width, height)) + side - 1) / side * side * side; 
+    }
+
+    std::size_t size() const {
+        return size_; 
+    }
+    std::size_t index(int x, int y) const 
+    {
+        const unsigned ux = x, uy = y; 
+        const unsigned mask = (1u << block_bits) - 1; 
+        // The shorter side fits into one block, so at most one of the coordinates is beyond the first block. 
+        const std::size_t block = (ux >> block_bits) + (uy >> block_bits); 
+        return (block << (2 * block_bits)) | spread_bits(ux & mask) | (spread_bits(uy & mask) << 1); 
+    }
+};
+
+template<typename ElemType, typename Layout = RowMajor>
 class Grid; // Forward declaration.
 
 // cf. on custom iterators: https://internalpointers.com/post/writing-custom-iterators-modern-cpp (last retrieved 2024-06-19)
-template<typename ElemType, bool is_const>
+// Indexes a column directly through a pointer to its first element; bounds are only checked by asserts (i.e. in Debug builds). 
+template<typename ElemType, bool is_const, typename Layout = RowMajor>
 struct GridColIterator 
 {
     using iterator_category = std::random_access_iterator_tag;
@@ -21,46 +133,39 @@ struct GridColIterator
     using value_type        = ElemType;
     using pointer           = typename std::conditional_t<is_const, const ElemType*, ElemType*>;  
     using reference         = typename std::conditional_t<is_const, const ElemType&, ElemType&>;
-    using parent_ptr_type   = typename std::conditional_t<is_const, const Grid<ElemType>*, Grid<ElemType>*>;
+    using parent_ptr_type   = typename std::conditional_t<is_const, const Grid<ElemType, Layout>*, Grid<ElemType, Layout>*>;
+
+    GridColIterator() = default; 
 
     GridColIterator(int column, int row, parent_ptr_type parent) : col(column), current_row(row), parent(parent) 
     {
         assert(parent);
-        if (parent == nullptr || !parent->pos_on_grid(col, row)) {
-            ptr = nullptr;
-        } else {
-            ptr = &parent->at(col, row);
+        if constexpr (Layout::contiguous_rows) {
+            stride = parent->stride(); 
         }
+        col_begin = col >= 0 && col < parent->width() ? parent->storage().data() + parent->index(col, 0) : nullptr; 
     };
 
-    reference operator*() const {assert(ptr != nullptr); return *ptr; }
-    pointer operator->() const {assert(ptr != nullptr); return ptr; }
+    reference operator*() const 
+    {
+        assert(on_grid()); 
+        if constexpr (Layout::contiguous_rows) {
+            return col_begin[static_cast<std::ptrdiff_t>(current_row) * stride]; 
+        } else {
+            return parent->storage()[parent->index(col, current_row)]; 
+        }
+    }
+    pointer operator->() const {assert(on_grid()); return &**this; }
 
     // Prefix:
     GridColIterator& operator++() 
     {
-        assert(parent);
-         if (current_row < parent->height() - 1 && current_row >= -1)  {
-            ++current_row;
-            ptr = &parent->at(col, current_row);
-         } else {
-            ++current_row;
-            ptr = nullptr;
-         }
-         return *this; 
+        return *this += 1; 
     }  
 
     GridColIterator& operator--() 
     {
-        assert(parent);
-         if (current_row > 0 && current_row <= parent->height())  {
-            --current_row;
-            ptr = &parent->at(col, current_row);
-         } else {
-            --current_row;
-            ptr = nullptr;
-         }
-         return *this; 
+        return *this += -1; 
     }  
 
     // Postfix: 
@@ -70,11 +175,6 @@ struct GridColIterator
     GridColIterator& operator+=(const difference_type& n) 
     {
         current_row += n;
-        if (current_row < 0 || current_row >= parent->height()) {
-            ptr = nullptr; 
-        } else {
-            ptr = &parent->at(col, current_row);
-        }
         return *this;
     }
 
@@ -84,26 +184,17 @@ struct GridColIterator
 
     GridColIterator operator+(const difference_type& n) const
     {
-        GridColIterator res = GridColIterator(col, current_row + n, parent);
-        if (res.current_row < 0 || res.current_row >= parent->height()) {
-            res.ptr = nullptr; 
-        } else {
-            res.ptr = &parent->at(col, res.current_row);
-        }
-        return res;
+        GridColIterator res = *this; 
+        return res += n; 
     }
 
     GridColIterator operator-(const difference_type& n) const {
         return *this + -n;
     }
 
-    ElemType& operator[](difference_type n) const
+    reference operator[](difference_type n) const
     {
-        int new_row = current_row - n;
-        if (new_row < 0 || new_row >= parent->height()) {
-            throw std::out_of_range("GridColIterator: subscript out of range");
-        }
-        return parent->at(col, new_row);
+        return *(*this + n);
     }
 
     difference_type operator-(const GridColIterator& other) const 
@@ -116,7 +207,7 @@ struct GridColIterator
     auto operator<=>(const GridColIterator& rhs) const
     {
         assert(col == rhs.col);
-        return current_row - rhs.current_row;
+        return current_row <=> rhs.current_row;
     }
 
     friend GridColIterator operator+(const difference_type& n, const GridColIterator& iter) 
@@ -124,256 +215,526 @@ struct GridColIterator
         return iter + n;
     }
 
-    friend GridColIterator operator-(const difference_type& n, const GridColIterator& iter)
-    {
-        return iter - n; 
-    }
-
     friend bool operator==(const GridColIterator& a, const GridColIterator& b) 
     {
         assert(a.col == b.col && a.parent == b.parent); 
-        bool eq = a.current_row == b.current_row; 
-        assert(!(eq && (a.ptr != b.ptr)));
-        return eq;
+        return a.current_row == b.current_row; 
     };
 
-    friend bool operator!=(const GridColIterator& a, const GridColIterator& b) 
-    {
-        assert(a.col == b.col && a.parent == b.parent);
-        return a.current_row != b.current_row;
-    };  
-
 private:
-    int col; 
-    int current_row;
+    bool on_grid() const {
+        return col_begin && current_row >= 0 && current_row < parent->height(); 
+    }
+
+    int col = 0; 
+    int current_row = 0;
+    int stride = 0; 
     parent_ptr_type parent = nullptr;
-    pointer ptr; 
+    pointer col_begin = nullptr; 
 };
 
 
+// Iterates over the elements in row-major order for layouts with contiguous rows, skipping the border (if any) from the end of one row to the next. 
 template<typename ElemType, bool is_const>
-struct GridIterator 
+struct GridCellIterator 
 {
-private: 
-    bool idx_on_grid(int idx) const {
-        return idx >= 0 && idx < std::ssize(parent->data);
-    }
-
-public:
     using iterator_category = std::random_access_iterator_tag;
     using difference_type   = int;
     using value_type        = ElemType;
     using pointer           = typename std::conditional_t<is_const, const ElemType*, ElemType*>;  
     using reference         = typename std::conditional_t<is_const, const ElemType&, ElemType&>;
-    using parent_ptr_type   = typename std::conditional_t<is_const, const Grid<ElemType>*, Grid<ElemType>*>;
 
-    GridIterator(int column, int row, parent_ptr_type parent) :  parent(parent) 
-    {
-        assert(parent);
-        current_idx = column + row * parent->width();
-        if (parent == nullptr || !idx_on_grid(current_idx)) {
-            ptr = nullptr;
-            // current_idx = current_idx < 0 ? -1 : std::ssize(parent->data);
-        } else {
-            ptr = &parent->data.at(current_idx);
-        }
-    };
+    GridCellIterator() = default; 
+    GridCellIterator(pointer row_begin, int width, std::ptrdiff_t stride) : current_row(row_begin), row_width(width), row_stride(stride) {}
 
-    reference operator*() const {if (!ptr) {std::cout << current_idx << "\n";} assert(ptr != nullptr); return *ptr; }
-    pointer operator->() const {assert(ptr != nullptr); return ptr; }
+    reference operator*() const {
+        return current_row[col]; 
+    }
+    pointer operator->() const {return &**this; }
 
-    // Prefix:
-    GridIterator& operator++() 
+    GridCellIterator& operator++() 
     {
-        assert(parent);
-        ++current_idx;
-
-        if (idx_on_grid(current_idx)) {
-            ptr = &parent->data.at(current_idx);
-        } else {
-            // current_idx = current_idx < 0 ? -1 : std::ssize(parent->data);
-            ptr = nullptr;
+        if (++col == row_width) {
+            col = 0; 
+            current_row += row_stride; 
         }
-         return *this;
-    }  
-
-    GridIterator& operator--() 
+        return *this; 
+    }
+    GridCellIterator& operator--() 
     {
-        assert(parent);
-        --current_idx;
-
-        if (idx_on_grid(current_idx)) {
-            ptr = &parent->data.at(current_idx);
-        } else {
-            // current_idx = current_idx < 0 ? -1 : std::ssize(parent->data);
-            ptr = nullptr;
+        if (col-- == 0) {
+            col = row_width - 1; 
+            current_row -= row_stride; 
         }
-         return *this;
-    }  
-
-    // Postfix: 
-    GridIterator operator++(int) { GridIterator tmp = *this; ++(*this); return tmp;}
-    GridIterator operator--(int) { GridIterator tmp = *this; --(*this); return tmp;}
+        return *this; 
+    }
+    GridCellIterator operator++(int) { GridCellIterator tmp = *this; ++(*this); return tmp;}
+    GridCellIterator operator--(int) { GridCellIterator tmp = *this; --(*this); return tmp;}
 
-    GridIterator& operator+=(const difference_type& n) 
+    GridCellIterator& operator+=(const difference_type& n) 
     {
-        assert(parent);
-        current_idx += n;
-
-        if (idx_on_grid(current_idx)) {
-            ptr = &parent->data.at(current_idx);
-        } else {
-            // current_idx = current_idx < 0 ? -1 : std::ssize(parent->data);
-            ptr = nullptr;
+        if (n == 0) {
+            return *this; 
         }
-        return *this;
+        int rows = (col + n) / row_width; 
+        col = (col + n) % row_width; 
+        if (col < 0) {
+            col += row_width; 
+            --rows; 
+        }
+        current_row += rows * row_stride; 
+        return *this; 
     }
+    GridCellIterator& operator-=(const difference_type& n) {return *this += -n; }
+    GridCellIterator operator+(const difference_type& n) const {GridCellIterator res = *this; return res += n; }
+    GridCellIterator operator-(const difference_type& n) const {return *this + -n; }
+    friend GridCellIterator operator+(const difference_type& n, const GridCellIterator& iter) {return iter + n; }
 
-    GridIterator& operator-=(const difference_type& n) {
-        return *this += -n;
-    }
+    reference operator[](difference_type n) const {return *(*this + n); }
 
-    GridIterator operator+(const difference_type& n) const
+    difference_type operator-(const GridCellIterator& other) const 
     {
-        assert(parent);
-        int current_col = current_idx % parent->width();
-        int current_row = current_idx / parent->width();
-        GridIterator res = GridIterator(current_col, current_row, parent);
-        res.current_idx = current_idx + n;;
-    
-        if (idx_on_grid(res.current_idx)) {
-            res.ptr = &parent->data.at(res.current_idx);
-        } else {
-            // res.current_idx = res.current_idx < 0 ? -1 : std::ssize(parent->data);
-            res.ptr = nullptr;
+        if (current_row == other.current_row) {
+            return col - other.col; 
         }
- 
-        return res;
+        return static_cast<difference_type>((current_row - other.current_row) / row_stride) * row_width + (col - other.col); 
     }
 
-    GridIterator operator-(const difference_type& n) const {
-        return *this + -n;
+    auto operator<=>(const GridCellIterator& rhs) const
+    {
+        if (auto cmp = current_row <=> rhs.current_row; cmp != 0) {
+            return cmp; 
+        }
+        return col <=> rhs.col; 
     }
 
-    ElemType& operator[](difference_type n) const
+    friend bool operator==(const GridCellIterator& a, const GridCellIterator& b) {
+        return a.current_row == b.current_row && a.col == b.col; 
+    };
+
+private:
+    pointer current_row = nullptr; // The first element of the row of the current element. 
+    int col = 0; 
+    int row_width = 0; 
+    std::ptrdiff_t row_stride = 0; 
+};
+
+
+// Iterates over the elements in row-major order for layouts without contiguous rows (looking up the storage index of every element). 
+template<typename ElemType, bool is_const, typename Layout>
+struct GridLayoutIterator 
+{
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = int;
+    using value_type        = ElemType;
+    using pointer           = typename std::conditional_t<is_const, const ElemType*, ElemType*>;  
+    using reference         = typename std::conditional_t<is_const, const ElemType&, ElemType&>;
+    using parent_ptr_type   = typename std::conditional_t<is_const, const Grid<ElemType, Layout>*, Grid<ElemType, Layout>*>;
+
+    GridLayoutIterator() = default; 
+    GridLayoutIterator(int idx, parent_ptr_type parent_grid) : current_idx(idx), parent(parent_grid) {}
+
+    reference operator*() const 
     {
-        difference_type new_idx = current_idx + n;
-        if (!idx_on_grid(new_idx)) {
-            throw std::out_of_range("GridIterator: subscript out of range.");
-        }
-        return parent->data.at(new_idx);
+        assert(parent && current_idx >= 0 && current_idx < parent->width() * parent->height()); 
+        return parent->storage()[parent->index(current_idx % parent->width(), current_idx / parent->width())]; 
     }
+    pointer operator->() const {return &**this; }
+
+    GridLayoutIterator& operator++() {++current_idx; return *this; }
+    GridLayoutIterator& operator--() {--current_idx; return *this; }
+    GridLayoutIterator operator++(int) { GridLayoutIterator tmp = *this; ++(*this); return tmp;}
+    GridLayoutIterator operator--(int) { GridLayoutIterator tmp = *this; --(*this); return tmp;}
+
+    GridLayoutIterator& operator+=(const difference_type& n) {current_idx += n; return *this; }
+    GridLayoutIterator& operator-=(const difference_type& n) {current_idx -= n; return *this; }
+    GridLayoutIterator operator+(const difference_type& n) const {return GridLayoutIterator(current_idx + n, parent); }
+    GridLayoutIterator operator-(const difference_type& n) const {return GridLayoutIterator(current_idx - n, parent); }
+    friend GridLayoutIterator operator+(const difference_type& n, const GridLayoutIterator& iter) {return iter + n; }
+
+    reference operator[](difference_type n) const {return *(*this + n); }
 
-    difference_type operator-(const GridIterator& other) const 
+    difference_type operator-(const GridLayoutIterator& other) const 
     {
         assert(parent == other.parent); 
         return current_idx - other.current_idx; 
     }
 
-    auto operator<=>(const GridIterator& rhs) const
+    auto operator<=>(const GridLayoutIterator& rhs) const
     {
         assert(rhs.parent == parent); 
-        return current_idx - rhs.current_idx; 
+        return current_idx <=> rhs.current_idx; 
     }
 
-    friend GridIterator operator+(const difference_type& n, const GridIterator& iter) 
+    friend bool operator==(const GridLayoutIterator& a, const GridLayoutIterator& b) 
     {
-        return iter + n;
-    }
+        assert(a.parent == b.parent); 
+        return a.current_idx == b.current_idx; 
+    };
 
-    friend GridIterator operator-(const difference_type& n, const GridIterator& iter)
+private:
+    int current_idx = 0;
+    parent_ptr_type parent = nullptr;
+};
+
+
+/*
+    The positions of a set of symbols on a grid (cf. Grid::index_symbols), in compressed sparse row form: 
+    the positions of the i-th symbol are positions_[offsets_[i]] to positions_[offsets_[i + 1] - 1] (in row-major order). 
+*/
+template<typename ElemType>
+class SymbolIndex 
+{
+    std::vector<ElemType> symbols_; 
+    std::vector<int> offsets_; 
+    std::vector<Vec2<int>> positions_; 
+
+public:
+    SymbolIndex(std::vector<ElemType> symbols, std::vector<int> offsets, std::vector<Vec2<int>> positions) 
+        : symbols_{std::move(symbols)}, offsets_{std::move(offsets)}, positions_{std::move(positions)} 
     {
-        return iter - n;
+        assert(offsets_.size() == symbols_.size() + 1 && offsets_.back() == std::ssize(positions_)); 
+    }
+
+    std::span<const ElemType> symbols() const {
+        return symbols_;
     }
 
-    friend bool operator==(const GridIterator& a, const GridIterator& b) 
+    // The positions of the i-th symbol. 
+    std::span<const Vec2<int>> operator[](std::size_t i) const 
     {
-        assert(a.parent == b.parent); 
-        bool eq = a.current_idx == b.current_idx; 
-        assert(!(eq && a.ptr != b.ptr));
-        return eq;
-    };
+        assert(i < symbols_.size()); 
+        return std::span<const Vec2<int>> {positions_}.subspan(offsets_[i], offsets_[i + 1] - offsets_[i]); 
+    }
 
-    friend bool operator!=(const GridIterator& a, const GridIterator& b) 
+    // The positions of symbol (empty if it was not indexed). 
+    std::span<const Vec2<int>> positions(const ElemType& symbol) const 
     {
-        assert(a.parent == b.parent); 
-        bool neq = a.current_idx != b.current_idx;
-        assert(!((a.ptr != nullptr) && neq && (a.ptr == b.ptr)));
-        return neq;
-    };  
+        auto found = std::find(symbols_.begin(), symbols_.end(), symbol); 
+        return found == symbols_.end() ? std::span<const Vec2<int>> {} : (*this)[found - symbols_.begin()]; 
+    }
 
-private:
-    int current_idx = 0;
-    parent_ptr_type parent = nullptr;
-    pointer ptr = nullptr; 
+    // The positions of all symbols (grouped by symbol). 
+    std::span<const Vec2<int>> all() const {
+        return positions_; 
+    }
 };
 
+namespace detail
+{
+struct SymbolHit {
+    int slot; // The index of the symbol. 
+    Vec2<int> pos; 
+}; 
+
+/*
+    Appends the positions of the symbols in the rows row_at(0) to row_at(height - 1) (spans of the elements) to hits. 
+    For char rows, the rows are scanned with aocio::for_each_byte_match (16/32 cells per comparison) if there are at most 
+    ByteSet::max_size symbols; otherwise, every cell is looked up in a table. 
+*/
+template<typename ElemType, typename RowFn>
+void find_row_symbols(int height, RowFn&& row_at, std::span<const ElemType> symbols, std::vector<SymbolHit>& hits)
+{
+    if constexpr (std::is_same_v<ElemType, char>) {
+        std::array<int, 256> slots; 
+        slots.fill(-1); 
+        for (int i = static_cast<int>(symbols.size()) - 1; i >= 0; --i) { // Backwards, so duplicates map to their first slot. 
+            slots[static_cast<unsigned char>(symbols[i])] = i; 
+        }
+        const bool use_byte_set = symbols.size() <= aocio::ByteSet::max_size; 
+        aocio::ByteSet set; 
+        if (use_byte_set) {
+            for (char sym : symbols) {
+                set.insert(sym); 
+            }
+        }
+        for (int y = 0; y < height; ++y) {
+            const std::span<const char> r = row_at(y); 
+            if (use_byte_set) {
+                aocio::for_each_byte_match(std::string_view {r.data(), r.size()}, set, [&hits, &slots, r, y](std::size_t x) {
+                    hits.push_back(SymbolHit {.slot = slots[static_cast<unsigned char>(r[x])], .pos = Vec2<int>{.x = static_cast<int>(x), .y = y}}); 
+                }); 
+            } else {
+                for (int x = 0; x < std::ssize(r); ++x) {
+                    if (const int slot = slots[static_cast<unsigned char>(r[x])]; slot >= 0) {
+                        hits.push_back(SymbolHit {.slot = slot, .pos = Vec2<int>{.x = x, .y = y}}); 
+                    }
+                }
+            }
+        }
+    } else {
+        for (int y = 0; y < height; ++y) {
+            const std::span<const ElemType> r = row_at(y); 
+            for (int x = 0; x < std::ssize(r); ++x) {
+                auto found = std::find(symbols.begin(), symbols.end(), r[x]); 
+                if (found != symbols.end()) {
+                    hits.push_back(SymbolHit {.slot = static_cast<int>(found - symbols.begin()), .pos = Vec2<int>{.x = x, .y = y}}); 
+                }
+            }
+        }
+    }
+}
 
+// Counting sort of the hits by symbol (stable, so the positions of every symbol stay in row-major order). 
 template<typename ElemType>
+SymbolIndex<ElemType> make_symbol_index(std::span<const ElemType> symbols, const std::vector<SymbolHit>& hits)
+{
+    std::vector<int> offsets(symbols.size() + 1, 0); 
+    for (const SymbolHit& hit : hits) {
+        ++offsets[hit.slot + 1]; 
+    }
+    for (std::size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1]; 
+    }
+    std::vector<int> next(offsets.begin(), offsets.end() - 1); 
+    std::vector<Vec2<int>> positions(hits.size()); 
+    for (const SymbolHit& hit : hits) {
+        positions[next[hit.slot]++] = hit.pos; 
+    }
+    return SymbolIndex<ElemType> {std::vector<ElemType>(symbols.begin(), symbols.end()), std::move(offsets), std::move(positions)}; 
+}
+}
+
+template<typename ElemType, typename Layout>
 class Grid 
 {
     std::vector<ElemType> data;
     int width_ = 0, height_ = 0; 
+    int border_ = 0; // Cells of sentinel value around the grid (on every side); only for RowMajor. 
+    Layout layout_ {}; 
 
-    using GridColIteratorMut = GridColIterator<ElemType, false>;
-    using GridColIteratorConst = GridColIterator<ElemType, true>;
-    using GridIteratorMut = GridIterator<ElemType, false>; 
-    using GridIteratorConst = GridIterator<ElemType, true>;
+    static constexpr bool contiguous_rows = Layout::contiguous_rows; 
 
-    friend GridColIteratorMut;
-    friend GridColIteratorConst;
-    friend GridIteratorMut;
-    friend GridIteratorConst;
+    using GridColIteratorMut = GridColIterator<ElemType, false, Layout>;
+    using GridColIteratorConst = GridColIterator<ElemType, true, Layout>;
+    // Both only cover the elements of the grid (not the border or padding of the storage), in row-major order. 
+    using GridIteratorMut = std::conditional_t<contiguous_rows, GridCellIterator<ElemType, false>, GridLayoutIterator<ElemType, false, Layout>>; 
+    using GridIteratorConst = std::conditional_t<contiguous_rows, GridCellIterator<ElemType, true>, GridLayoutIterator<ElemType, true, Layout>>;
+    // With contiguous rows, plain pointers serve as (unchecked) iterators over a single row. 
+    using GridRowIteratorMut = std::conditional_t<contiguous_rows, ElemType*, GridIteratorMut>; 
+    using GridRowIteratorConst = std::conditional_t<contiguous_rows, const ElemType*, GridIteratorConst>;
 
     using RowType = std::conditional_t<std::is_same<ElemType, char>::value, std::string, std::vector<ElemType>>;
 
-    int calc_idx(int x, int y) const {
-        return x + y * width();
+    std::size_t calc_idx(int x, int y) const {
+        return layout_.index(x, y);
+    }
+
+    // The element at (0, 0) in the storage (with contiguous rows). 
+    ElemType* first_elem() {
+        return data.data() + (data.empty() ? 0 : calc_idx(0, 0));
+    }
+    const ElemType* first_elem() const {
+        return data.data() + (data.empty() ? 0 : calc_idx(0, 0));
+    }
+
+    void init_layout() 
+    {
+        if constexpr (contiguous_rows) {
+            layout_ = Layout {width_, height_, border_}; 
+        } else {
+            layout_ = Layout {width_, height_}; 
+        }
     }
 
-    Vec2<int> idx_to_pos(int idx) const 
+    Vec2<int> idx_to_pos(std::size_t idx) const 
     {
-        int y = idx / width(); 
-        int x = idx % width();
-        assert(x >= 0 && x < width());
-        assert(y >= 0 && y < height());
+        static_assert(contiguous_rows, "Grid: Positions of storage indices are only available with contiguous rows"); 
+        int y = static_cast<int>(idx / stride()) - border_; 
+        int x = static_cast<int>(idx % stride()) - border_;
+        assert(x >= -border_ && x < width() + border_);
+        assert(y >= -border_ && y < height() + border_);
         return Vec2<int>{.x = x, .y = y};
     }
 
+    /*
+        Cache-oblivious transposition: the blocks are halved along their longer side until they are small enough 
+        for both the source and destination rows of a block to stay in the cache (whatever its size). 
+        cf. https://en.wikipedia.org/wiki/Cache-oblivious_algorithm#Matrix_transposition (last retrieved 2024-07-06)
+    */
+    static constexpr int transpose_leaf_size = 16; 
+
+    // dst(y, x) = src(x, y) for x in [x0, x1), y in [y0, y1).
+    static void transpose_block(const ElemType* src, int src_stride, ElemType* dst, int dst_stride, int x0, int x1, int y0, int y1)
+    {
+        if (x1 - x0 <= transpose_leaf_size && y1 - y0 <= transpose_leaf_size) {
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    dst[y + static_cast<std::ptrdiff_t>(x) * dst_stride] = src[x + static_cast<std::ptrdiff_t>(y) * src_stride]; 
+                }
+            }
+        } else if (x1 - x0 >= y1 - y0) {
+            const int xm = x0 + (x1 - x0) / 2; 
+            transpose_block(src, src_stride, dst, dst_stride, x0, xm, y0, y1); 
+            transpose_block(src, src_stride, dst, dst_stride, xm, x1, y0, y1); 
+        } else {
+            const int ym = y0 + (y1 - y0) / 2; 
+            transpose_block(src, src_stride, dst, dst_stride, x0, x1, y0, ym); 
+            transpose_block(src, src_stride, dst, dst_stride, x0, x1, ym, y1); 
+        }
+    }
+
+    // Swaps (x, y) and (y, x) for x in [x0, x1), y in [y0, y1) (a block strictly above the diagonal of a square grid). 
+    static void transpose_swap_block(ElemType* d, int stride, int x0, int x1, int y0, int y1)
+    {
+        if (x1 - x0 <= transpose_leaf_size && y1 - y0 <= transpose_leaf_size) {
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    std::swap(d[x + static_cast<std::ptrdiff_t>(y) * stride], d[y + static_cast<std::ptrdiff_t>(x) * stride]); 
+                }
+            }
+        } else if (x1 - x0 >= y1 - y0) {
+            const int xm = x0 + (x1 - x0) / 2; 
+            transpose_swap_block(d, stride, x0, xm, y0, y1); 
+            transpose_swap_block(d, stride, xm, x1, y0, y1); 
+        } else {
+            const int ym = y0 + (y1 - y0) / 2; 
+            transpose_swap_block(d, stride, x0, x1, y0, ym); 
+            transpose_swap_block(d, stride, x0, x1, ym, y1); 
+        }
+    }
+
+    // Transposes the square block [begin, end)^2 on the diagonal in place. 
+    static void transpose_diagonal_block(ElemType* d, int stride, int begin, int end)
+    {
+        if (end - begin <= transpose_leaf_size) {
+            for (int y = begin; y < end; ++y) {
+                for (int x = y + 1; x < end; ++x) {
+                    std::swap(d[x + static_cast<std::ptrdiff_t>(y) * stride], d[y + static_cast<std::ptrdiff_t>(x) * stride]); 
+                }
+            }
+            return; 
+        }
+        const int mid = begin + (end - begin) / 2; 
+        transpose_diagonal_block(d, stride, begin, mid); 
+        transpose_diagonal_block(d, stride, mid, end); 
+        transpose_swap_block(d, stride, mid, end, begin, mid); 
+    }
+
+    void check_transformable(const char* err) const
+    {
+        static_assert(contiguous_rows, "Grid: Transformations are only supported by the RowMajor layout"); 
+        if (border_) {
+            throw std::logic_error(err); 
+        }
+    }
+
 public: 
     Grid() = default; 
 
-    Grid(const std::vector<RowType>& rows) 
+    Grid(std::span<const RowType> rows) 
     {
         if (!rows.size()) {
             return;
         }
-        width_ = rows.at(0).size();
+        width_ = rows[0].size();
+        height_ = rows.size();
+        init_layout(); 
+        if constexpr (contiguous_rows) {
+            data.reserve(layout_.size()); 
+            for (const auto& row : rows) {
+                if (std::ssize(row) != width_) {
+                    throw std::invalid_argument("Grid::Grid: Rows of different width");
+                }
+                data.insert(data.end(), row.begin(), row.end()); 
+            }
+        } else {
+            data.resize(layout_.size()); 
+            for (int y = 0; y < height_; ++y) {
+                if (std::ssize(rows[y]) != width_) {
+                    throw std::invalid_argument("Grid::Grid: Rows of different width");
+                }
+                for (int x = 0; x < width_; ++x) {
+                    data[calc_idx(x, y)] = rows[y][x]; 
+                }
+            }
+        }
+    }
+
+    /*
+        Surrounds the grid with border cells of value sentinel on every side (e.g. '#', or a value which does not occur in the grid). 
+        Positions stay the same (the border is at x = -1, x = width() etc.), but operator[] and index() also accept positions 
+        in the border, so neighbour lookups of cells on the grid need no bounds checks, e.g. grid.storage()[idx + grid.offset(dir)]. 
+        (pos_on_grid, at, get, set, try_get, row(), begin(), end() and the row/column iterators only cover the grid itself; 
+        only storage() covers the whole storage including the border.)
+    */
+    Grid(std::span<const RowType> rows, int border, const ElemType& sentinel) 
+    {
+        static_assert(contiguous_rows, "Grid: Borders are only supported by the RowMajor layout"); 
+        if (border < 0) {
+            throw std::invalid_argument("Grid::Grid: Negative border");
+        }
+        width_ = rows.size() ? std::ssize(rows[0]) : 0;
         height_ = rows.size();
-        for (const auto& row : rows) {
-            if (std::ssize(row) != width_) {
+        border_ = border; 
+        init_layout(); 
+        data.assign(layout_.size(), sentinel); 
+        for (int y = 0; y < height_; ++y) {
+            if (std::ssize(rows[y]) != width_) {
                 throw std::invalid_argument("Grid::Grid: Rows of different width");
             }
-            for (const auto & elem : row) {
-                data.push_back(elem);
+            std::copy(rows[y].begin(), rows[y].end(), data.begin() + calc_idx(0, y)); 
+        }
+    }
+
+    // Takes the elements in row-major order (e.g. from the input cache). 
+    Grid(int width, int height, std::span<const ElemType> elems) : width_{width}, height_{height} 
+    {
+        if (width < 0 || height < 0 || std::ssize(elems) != static_cast<int64_t>(width) * height) {
+            throw std::invalid_argument("Grid::Grid: Number of elements does not match width * height");
+        }
+        init_layout(); 
+        if constexpr (contiguous_rows) {
+            data.assign(elems.begin(), elems.end()); 
+        } else {
+            data.resize(layout_.size()); 
+            for (int y = 0; y < height_; ++y) {
+                for (int x = 0; x < width_; ++x) {
+                    data[calc_idx(x, y)] = elems[x + static_cast<std::size_t>(y) * width_]; 
+                }
+            }
+        }
+    }
+
+    // Copies height rows of width elements which are stride elements apart, e.g. the lines of a text buffer (cf. GridView in grid-view.hpp). 
+    Grid(int width, int height, const ElemType* first, std::ptrdiff_t stride) : width_{width}, height_{height} 
+    {
+        if (width < 0 || height < 0 || stride < width) {
+            throw std::invalid_argument("Grid::Grid: Invalid size or stride");
+        }
+        init_layout(); 
+        if constexpr (contiguous_rows) {
+            data.reserve(layout_.size()); 
+            for (int y = 0; y < height_; ++y) {
+                data.insert(data.end(), first + y * stride, first + y * stride + width_); 
+            }
+        } else {
+            data.resize(layout_.size()); 
+            for (int y = 0; y < height_; ++y) {
+                for (int x = 0; x < width_; ++x) {
+                    data[calc_idx(x, y)] = first[x + y * stride]; 
+                }
             }
         }
     }
 
     void push_row(const RowType& row) 
     {
+        static_assert(contiguous_rows, "Grid push_row: Only supported by the RowMajor layout"); 
+        if (border_) {
+            throw std::logic_error("Grid push_row: Grid has a border");
+        }
         if (width_ != 0 && !(std::ssize(row) == width_)) {
             throw  std::out_of_range("Grid add_row: row size does not match");
         } else {
             width_ = std::ssize(row);
         }
-        for (const auto& elem : row) {
-            data.push_back(elem);
-        }
+        data.insert(data.end(), row.begin(), row.end()); 
         ++height_;
         if (width_ == 0 || height_ == 0) {
             throw std::runtime_error("Grid: Tried to push empty row.");
         }
+        init_layout(); 
     }
 
     std::optional<ElemType> try_get(int x, int y) const 
@@ -381,7 +742,7 @@ public:
         if (!pos_on_grid(x, y)) {
             return {};
         }
-        return data.at(calc_idx(x, y));
+        return data[calc_idx(x, y)];
     }
     std::optional<ElemType> try_get(const Vec2<int>& pos) const {
         return try_get(pos.x, pos.y); 
@@ -392,7 +753,7 @@ public:
         if (!pos_on_grid(x, y)) {
             throw std::out_of_range("Grid get: invalid position");
         }
-        return data.at(calc_idx(x, y));
+        return data[calc_idx(x, y)];
     }
     ElemType get(const Vec2<int>& pos) const {
         return get(pos.x, pos.y);
@@ -403,7 +764,7 @@ public:
         if (!pos_on_grid(x, y)) {
             throw std::out_of_range("Grid set: invalid position");
         }
-        data.at(calc_idx(x, y)) = e;
+        data[calc_idx(x, y)] = e;
     }
     void set(const Vec2<int>& pos, ElemType e) {
         set(pos.x, pos.y, e);
@@ -414,11 +775,11 @@ public:
         if (!pos_on_grid(x, y)) {
             return false;
         }
-        set(x, y);
+        set(x, y, e);
         return true;
     }
     bool try_set(const Vec2<int>& pos, ElemType e) {
-        return try_set(pos.x, pos.y);
+        return try_set(pos.x, pos.y, e);
     }
 
     ElemType& at(int x, int y) 
@@ -426,7 +787,7 @@ public:
         if (!pos_on_grid(x, y)) {
             throw std::out_of_range("Grid at: invalid position");
         }
-        return data.at(calc_idx(x, y));
+        return data[calc_idx(x, y)];
     }
     ElemType& at(const Vec2<int>& pos) {
         return at(pos.x, pos.y);
@@ -437,26 +798,44 @@ public:
         if (!pos_on_grid(x, y)) {
             throw std::out_of_range("Grid at: invalid position");
         }
-        return data.at(calc_idx(x, y));
+        return data[calc_idx(x, y)];
     }
     const ElemType& at(const Vec2<int>& pos) const {
         return at(pos.x, pos.y);
     }
 
+    // Unchecked; pos may also be in the border (if any). 
     ElemType& operator[](const Vec2<int>& pos) 
     {
-        assert(calc_idx(pos.x, pos.y) >= 0 && calc_idx(pos.x, pos.y) < std::ssize(data));
-        return data[calc_idx(pos.x, pos.y)]; 
+        return data[index(pos)]; 
     }
     const ElemType& operator[](const Vec2<int>& pos) const 
     {
-        assert(calc_idx(pos.x, pos.y) >= 0 && calc_idx(pos.x, pos.y) < std::ssize(data));
-        return data[calc_idx(pos.x, pos.y)]; 
+        return data[index(pos)]; 
+    }
+
+    // The index of pos in storage() (pos may be in the border). 
+    std::size_t index(int x, int y) const 
+    {
+        assert(x >= -border_ && x < width_ + border_ && y >= -border_ && y < height_ + border_);
+        return calc_idx(x, y); 
+    }
+    std::size_t index(const Vec2<int>& pos) const {
+        return index(pos.x, pos.y);
+    }
+
+    // The difference of the indices of neighbouring cells, e.g. offset(dir_to_vec2<int>(Direction::Up)) (only with contiguous rows). 
+    int offset(const Vec2<int>& dir) const {
+        return dir.x + dir.y * stride();
+    }
+
+    Vec2<int> position(std::size_t idx) const {
+        return idx_to_pos(idx); 
     }
 
     bool pos_on_grid(int x, int y) const {
         bool on_grid = x >= 0 && x < width_ && y >= 0 && y < height_; 
-        assert(!(on_grid && (calc_idx(x, y) >= std::ssize(data) || calc_idx(x, y) < 0)));
+        assert(!(on_grid && calc_idx(x, y) >= data.size()));
         return on_grid;
     }
     bool pos_on_grid(const Vec2<int>& pos) const {
@@ -469,19 +848,80 @@ public:
     int width() const {
         return width_;
     }
+    int border() const {
+        return border_;
+    }
+    // The number of elements from one row to the next in storage() (only with contiguous rows). 
+    int stride() const {
+        static_assert(contiguous_rows, "Grid stride: Rows are not contiguous in this layout"); 
+        return width_ + 2 * border_;
+    }
+
+    // All elements of the grid in row-major order (without the border, if any; use storage() for the whole storage). 
+    GridIteratorMut begin() 
+    {
+        if constexpr (contiguous_rows) {
+            return GridIteratorMut(first_elem(), width_, stride());
+        } else {
+            return GridIteratorMut(0, this); 
+        }
+    }
+    GridIteratorMut end() 
+    {
+        if constexpr (contiguous_rows) {
+            return width_ && height_ ? GridIteratorMut(first_elem() + static_cast<std::ptrdiff_t>(height_) * stride(), width_, stride()) : begin();
+        } else {
+            return GridIteratorMut(width_ * height_, this); 
+        }
+    }
 
-    GridIteratorMut begin() {
-        return GridIteratorMut(0, 0, this);
+    GridIteratorConst begin() const {
+        return cbegin(); 
     }
-    GridIteratorMut end() {
-        return GridIteratorMut(width(), height() - 1, this);
+    GridIteratorConst end() const {
+        return cend(); 
     }
 
-    GridIteratorConst cbegin() const {
-        return GridIteratorConst(0, 0, this);
+    GridIteratorConst cbegin() const 
+    {
+        if constexpr (contiguous_rows) {
+            return GridIteratorConst(first_elem(), width_, stride());
+        } else {
+            return GridIteratorConst(0, this); 
+        }
     }
-    GridIteratorConst cend() const {
-        return GridIteratorConst(width(), height() - 1, this);
+    GridIteratorConst cend() const 
+    {
+        if constexpr (contiguous_rows) {
+            return width_ && height_ ? GridIteratorConst(first_elem() + static_cast<std::ptrdiff_t>(height_) * stride(), width_, stride()) : cbegin();
+        } else {
+            return GridIteratorConst(width_ * height_, this); 
+        }
+    }
+
+    // The whole storage in the order of the layout (including the border or padding, if any); index() gives the position of an element in it. 
+    std::span<ElemType> storage() {
+        return data;
+    }
+    std::span<const ElemType> storage() const {
+        return data;
+    }
+
+    const Layout& layout() const {
+        return layout_;
+    }
+
+    std::span<ElemType> row(int y) 
+    {
+        static_assert(contiguous_rows, "Grid row: Rows are not contiguous in this layout"); 
+        assert(y >= 0 && y < height_);
+        return std::span<ElemType> {data.data() + calc_idx(0, y), static_cast<std::size_t>(width_)};
+    }
+    std::span<const ElemType> row(int y) const 
+    {
+        static_assert(contiguous_rows, "Grid row: Rows are not contiguous in this layout"); 
+        assert(y >= 0 && y < height_);
+        return std::span<const ElemType> {data.data() + calc_idx(0, y), static_cast<std::size_t>(width_)};
     }
 
 
@@ -502,45 +942,110 @@ public:
     }
 
 
-    GridIteratorMut begin_row(int row) {
-        return GridIteratorMut(0, row, this);
+    GridRowIteratorMut begin_row(int y) 
+    {
+        if constexpr (contiguous_rows) {
+            return row(y).data();
+        } else {
+            return GridIteratorMut(y * width_, this); 
+        }
     }
 
-    GridIteratorMut end_row(int row) {
-        return GridIteratorMut(0, row + 1, this);
+    GridRowIteratorMut end_row(int y) {
+        return begin_row(y) + width_;
     }
 
-    GridIteratorConst cbegin_row(int row) const {
-        return GridIteratorConst(0, row, this);
+    GridRowIteratorConst cbegin_row(int y) const 
+    {
+        if constexpr (contiguous_rows) {
+            return row(y).data();
+        } else {
+            return GridIteratorConst(y * width_, this); 
+        }
     }
 
-    GridIteratorConst cend_row(int row) const {
-        return GridIteratorConst(0, row + 1, this);
+    GridRowIteratorConst cend_row(int y) const {
+        return cbegin_row(y) + width_;
     }
 
-    std::vector<Vec2<int>> find_elem_positions(const ElemType& elem) const
+    // Mirrors the grid at its diagonal (in place for square grids, otherwise into new storage). 
+    void transpose()
     {
-        std::vector<Vec2<int>> positions;
+        check_transformable("Grid transpose: Grid has a border"); 
+        if (width_ == height_) {
+            transpose_diagonal_block(data.data(), width_, 0, width_); 
+            return; 
+        }
+        std::vector<ElemType> transposed(data.size()); 
+        transpose_block(data.data(), width_, transposed.data(), height_, 0, width_, 0, height_); 
+        data = std::move(transposed); 
+        std::swap(width_, height_); 
+        init_layout(); 
+    }
 
-        auto start_pos = cbegin(); 
-        std::size_t i = 0; 
-        while (true) {
-            assert(i <= data.size());
-            auto found_pos = std::find(start_pos, cend(), elem); 
-            if (found_pos == cend()) {
-                return positions;
-            } else {
-                int idx = found_pos - cbegin();
-                assert(idx >= 0 && idx < std::ssize(data));
-                positions.push_back(idx_to_pos(idx));
-                start_pos = std::next(found_pos);
-            }
-            ++i; 
+    // Reverses every row. 
+    void flip_x()
+    {
+        check_transformable("Grid flip_x: Grid has a border"); 
+        for (int y = 0; y < height_; ++y) {
+            std::reverse(begin_row(y), end_row(y)); 
+        }
+    }
+
+    // Reverses the order of the rows. 
+    void flip_y()
+    {
+        check_transformable("Grid flip_y: Grid has a border"); 
+        for (int y = 0; y < height_ / 2; ++y) {
+            std::swap_ranges(begin_row(y), end_row(y), begin_row(height_ - 1 - y)); 
         }
-        assert(false);
     }
 
-    friend std::ostream& operator<<(std::ostream& os, const Grid<ElemType>& g) 
+    // By 90 degrees, e.g. the left column becomes the top row. 
+    void rotate_cw()
+    {
+        transpose(); 
+        flip_x(); 
+    }
+
+    // By 90 degrees, e.g. the top row becomes the left column. 
+    void rotate_ccw()
+    {
+        transpose(); 
+        flip_y(); 
+    }
+
+    /*
+        The positions of all given symbols (not in the border), found in a single pass over the rows (cf. detail::find_row_symbols), 
+        e.g. const auto idx = grid.index_symbols({'S', '#'}); for (const Vec2<int>& rock : idx.positions('#')) {...}
+    */
+    SymbolIndex<ElemType> index_symbols(std::span<const ElemType> symbols) const
+    {
+        std::vector<detail::SymbolHit> hits; 
+        if constexpr (contiguous_rows) {
+            detail::find_row_symbols(height_, [this](int y) {return row(y);}, symbols, hits); 
+        } else {
+            std::vector<ElemType> row_elems(width_); 
+            detail::find_row_symbols(height_, [this, &row_elems](int y) {
+                for (int x = 0; x < width_; ++x) {
+                    row_elems[x] = data[calc_idx(x, y)]; 
+                }
+                return std::span<const ElemType> {row_elems}; 
+            }, symbols, hits); 
+        }
+        return detail::make_symbol_index(symbols, hits); 
+    }
+    SymbolIndex<ElemType> index_symbols(std::initializer_list<ElemType> symbols) const {
+        return index_symbols(std::span<const ElemType> {symbols.begin(), symbols.size()}); 
+    }
+
+    std::vector<Vec2<int>> find_elem_positions(const ElemType& elem) const
+    {
+        const SymbolIndex<ElemType> idx = index_symbols(std::span<const ElemType> {&elem, 1}); 
+        return std::vector<Vec2<int>>(idx[0].begin(), idx[0].end()); 
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Grid& g) 
     {
         for (int row_n = 0; row_n < g.height(); ++row_n) {
             for (auto elem = g.cbegin_row(row_n); elem != g.cend_row(row_n); ++elem) {
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+    Binary cache of parsed input data (e.g. the parsed hands of day 7), so later runs don't have to parse the text input again.
+    A cache file lives next to the input (cf. cache_path) and consists of a header with the hash of the input bytes,
+    a table of sections and the sections themselves, each one a flat array of trivially copyable elements (little-endian,
+    i.e. simply their in-memory representation; on big-endian targets caching is disabled).
+    InputCache memory-maps the file and hands out spans into the mapping; if the hash does not match the current input
+    (or the file is missing or broken), open fails and the day parses its input as usual and writes a new cache with CacheWriter.
+    Every cache also records a schema tag given by the day (e.g. "day-07 hands v1"), which open compares as well:
+    change the tag whenever the cached types, their meaning or the parsing change, so caches of the old code count as missing.
+    Likewise get returns std::nullopt for a section which does not fit the requested type, which the day treats as a cache miss
+    (i.e. it parses again and overwrites the cache).
+*/
+
+namespace aocio
+{
+
+constexpr bool input_cache_supported = std::endian::native == std::endian::little;
+
+// FNV-1a, cf. https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function (last retrieved 2024-07-02)
+inline uint64_t hash_bytes(std::string_view bytes)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for (char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+// E.g. cache_path("input/day-07.txt", "hands") -> "input/day-07.txt.hands.cache"
+inline std::string cache_path(std::string_view input_path, std::string_view name)
+{
+    std::string path {input_path};
+    path += ".";
+    path += name;
+    path += ".cache";
+    return path;
+}
+
+namespace detail
+{
+constexpr uint32_t cache_magic = 0x43434f41; // "AOCC"
+constexpr uint32_t cache_version = 2;
+constexpr std::size_t cache_alignment = 16;
+
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t input_hash;
+    uint64_t schema_hash; // Of the schema tag.
+    uint64_t num_sections;
+};
+
+struct CacheSection {
+    uint64_t offset; // From the start of the file.
+    uint64_t count;
+    uint64_t elem_size;
+};
+}
+
+class CacheWriter
+{
+    struct Section {
+        std::vector<char> bytes;
+        uint64_t count, elem_size;
+    };
+    std::vector<Section> sections;
+
+public:
+    // Returns the index of the section.
+    template <typename T>
+    std::size_t add(std::span<const T> elems)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "CacheWriter: Elements must be trivially copyable");
+        static_assert(alignof(T) <= detail::cache_alignment);
+        Section& sec = sections.emplace_back();
+        sec.bytes.resize(elems.size_bytes());
+        if (!elems.empty()) {
+            std::memcpy(sec.bytes.data(), elems.data(), elems.size_bytes());
+        }
+        sec.count = elems.size();
+        sec.elem_size = sizeof(T);
+        return sections.size() - 1;
+    }
+
+    template <typename T>
+    std::size_t add(const std::vector<T>& elems) {
+        return add(std::span<const T> {elems});
+    }
+
+    // Writes to a temporary file first which is then renamed, so a reader never sees a half-written cache.
+    bool write(const std::string& path, uint64_t input_hash, std::string_view schema) const
+    {
+        if constexpr (!input_cache_supported) {
+            return false;
+        }
+        const detail::CacheHeader header {.magic = detail::cache_magic, .version = detail::cache_version,
+                                          .input_hash = input_hash, .schema_hash = hash_bytes(schema), .num_sections = sections.size()};
+        auto align_up = [](uint64_t offset) {
+            return (offset + detail::cache_alignment - 1) / detail::cache_alignment * detail::cache_alignment;
+        };
+
+        std::vector<detail::CacheSection> table;
+        uint64_t offset = align_up(sizeof(header) + sections.size() * sizeof(detail::CacheSection));
+        for (const Section& sec : sections) {
+            table.push_back(detail::CacheSection {.offset = offset, .count = sec.count, .elem_size = sec.elem_size});
+            offset = align_up(offset + sec.bytes.size());
+        }
+
+        const std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream file {tmp_path, std::ios::binary | std::ios::trunc};
+            if (!file) {
+                return false;
+            }
+            const char padding[detail::cache_alignment] {};
+            auto pad_to = [&file, &padding](uint64_t pos) {
+                file.write(padding, pos - static_cast<uint64_t>(file.tellp()));
+            };
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(detail::CacheSection));
+            for (std::size_t i = 0; i < sections.size(); ++i) {
+                pad_to(table[i].offset);
+                file.write(sections[i].bytes.data(), sections[i].bytes.size());
+            }
+            if (!file) {
+                return false;
+            }
+        }
+        return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+    }
+};
+
+class InputCache
+{
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::span<const detail::CacheSection> sections_;
+
+    void unmap()
+    {
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+        sections_ = {};
+    }
+
+    bool valid(uint64_t input_hash, std::string_view schema) const
+    {
+        if (size_ < sizeof(detail::CacheHeader)) {
+            return false;
+        }
+        detail::CacheHeader header;
+        std::memcpy(&header, data_, sizeof(header));
+        if (header.magic != detail::cache_magic || header.version != detail::cache_version || header.input_hash != input_hash || header.schema_hash != hash_bytes(schema)) {
+            return false;
+        }
+        if (header.num_sections > (size_ - sizeof(header)) / sizeof(detail::CacheSection)) {
+            return false;
+        }
+        const auto* table = reinterpret_cast<const detail::CacheSection*>(data_ + sizeof(header));
+        for (uint64_t i = 0; i < header.num_sections; ++i) {
+            const detail::CacheSection& sec = table[i];
+            if (sec.offset > size_ || (sec.elem_size && sec.count > (size_ - sec.offset) / sec.elem_size)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    InputCache() = default;
+    InputCache(const InputCache&) = delete;
+    InputCache& operator=(const InputCache&) = delete;
+
+    ~InputCache()
+    {
+        unmap();
+    }
+
+    // Returns false (silently) if there is no valid cache with the given schema tag for the input with the given hash.
+    bool open(const std::string& path, uint64_t input_hash, std::string_view schema)
+    {
+        unmap();
+        if constexpr (!input_cache_supported) {
+            return false;
+        }
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == -1 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        data_ = static_cast<const char*>(mapped);
+        size_ = st.st_size;
+        if (!valid(input_hash, schema)) {
+            unmap();
+            return false;
+        }
+        const auto* header = reinterpret_cast<const detail::CacheHeader*>(data_);
+        sections_ = {reinterpret_cast<const detail::CacheSection*>(data_ + sizeof(detail::CacheHeader)), header->num_sections};
+        return true;
+    }
+
+    std::size_t num_sections() const {
+        return sections_.size();
+    }
+
+    // The span points into the mapping, i.e. it is only valid as long as the InputCache is.
+    // std::nullopt if there is no such section or it does not match the element type (to be treated as a cache miss).
+    template <typename T>
+    std::optional<std::span<const T>> get(std::size_t section_idx) const
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "InputCache: Elements must be trivially copyable");
+        if (section_idx >= sections_.size()) {
+            return std::nullopt;
+        }
+        const detail::CacheSection& sec = sections_[section_idx];
+        if (sec.elem_size != sizeof(T) || sec.offset % alignof(T) != 0) {
+            return std::nullopt;
+        }
+        return std::span<const T> {reinterpret_cast<const T*>(data_ + sec.offset), sec.count};
+    }
+};
+
+}
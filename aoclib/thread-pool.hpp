@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace aocutil
+{
+
+/*
+    Fixed number of worker threads taking tasks from a shared FIFO queue.
+    submit returns a std::future for the result of the task (exceptions thrown by the task are rethrown by future::get).
+    The destructor finishes all queued tasks before joining the workers.
+*/
+class ThreadPool
+{
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable task_available;
+    bool stopping = false;
+
+    void work()
+    {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock {mutex};
+                task_available.wait(lock, [this] {return stopping || !tasks.empty();});
+                if (tasks.empty()) { // Only if stopping.
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+public:
+    static std::size_t default_num_threads()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    explicit ThreadPool(std::size_t num_threads = default_num_threads())
+    {
+        num_threads = std::max<std::size_t>(num_threads, 1);
+        workers.reserve(num_threads);
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            workers.emplace_back([this] {work();});
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::scoped_lock lock {mutex};
+            stopping = true;
+        }
+        task_available.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::size_t size() const {
+        return workers.size();
+    }
+
+    template <typename Fn>
+    std::future<std::invoke_result_t<Fn>> submit(Fn&& f)
+    {
+        // std::function needs a copyable callable, hence the shared_ptr around the (move-only) packaged_task.
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Fn>()>>(std::forward<Fn>(f));
+        std::future<std::invoke_result_t<Fn>> result = task->get_future();
+        {
+            std::scoped_lock lock {mutex};
+            tasks.emplace([task] {(*task)();});
+        }
+        task_available.notify_one();
+        return result;
+    }
+};
+
+}
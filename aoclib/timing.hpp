@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+    Scoped timers for the phases of a day (e.g. AOC_PHASE("parse"); at the start of a block), measured with steady_clock.
+    Every run of a phase adds one sample; report prints min/median/p99 per phase (in the order the phases first ran)
+    as a table or as JSON. cf. aocio::timed_runs (aocio.hpp) for --repeat N, --warmup M, --time and --json.
+*/
+
+namespace aocio
+{
+
+class PhaseTimings
+{
+    struct Phase {
+        std::string name;
+        std::vector<int64_t> samples_ns;
+    };
+    std::vector<Phase> phases; // Only a handful of phases, so a linear search is fine.
+
+    static double percentile_ms(const std::vector<int64_t>& sorted_ns, double p)
+    {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(p * sorted_ns.size()));
+        return sorted_ns.at(std::clamp<std::size_t>(rank, 1, sorted_ns.size()) - 1) / 1e6;
+    }
+
+public:
+    void record(std::string_view phase_name, int64_t duration_ns)
+    {
+        auto phase = std::find_if(phases.begin(), phases.end(), [phase_name](const Phase& p) {return p.name == phase_name;});
+        if (phase == phases.end()) {
+            phases.push_back(Phase {.name = std::string {phase_name}, .samples_ns = {}});
+            phase = std::prev(phases.end());
+        }
+        phase->samples_ns.push_back(duration_ns);
+    }
+
+    void clear()
+    {
+        phases.clear();
+    }
+
+    bool empty() const {
+        return phases.empty();
+    }
+
+    void report(std::ostream& os, std::string_view label, bool json) const
+    {
+        if (json) {
+            os << "{\"name\": \"" << label << "\", \"phases\": [";
+        } else {
+            os << std::left << std::setw(12) << "Phase" << std::right << std::setw(8) << "Runs"
+               << std::setw(14) << "Min (ms)" << std::setw(14) << "Median (ms)" << std::setw(14) << "P99 (ms)" << "\n";
+        }
+        for (const Phase& phase : phases) {
+            std::vector<int64_t> sorted = phase.samples_ns;
+            std::sort(sorted.begin(), sorted.end());
+            const double min = sorted.front() / 1e6, median = percentile_ms(sorted, 0.5), p99 = percentile_ms(sorted, 0.99);
+            if (json) {
+                os << (&phase != &phases.front() ? ", " : "") << "{\"name\": \"" << phase.name << "\", \"runs\": " << sorted.size()
+                   << ", \"min_ms\": " << min << ", \"median_ms\": " << median << ", \"p99_ms\": " << p99 << "}";
+            } else {
+                os << std::left << std::setw(12) << phase.name << std::right << std::setw(8) << sorted.size() << std::fixed << std::setprecision(3)
+                   << std::setw(14) << min << std::setw(14) << median << std::setw(14) << p99 << "\n" << std::defaultfloat;
+            }
+        }
+        if (json) {
+            os << "]}\n";
+        }
+    }
+};
+
+inline PhaseTimings& phase_timings()
+{
+    static PhaseTimings timings;
+    return timings;
+}
+
+class ScopedPhase
+{
+    std::string_view name;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedPhase(std::string_view phase_name) : name{phase_name}, start{std::chrono::steady_clock::now()} {}
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    ~ScopedPhase()
+    {
+        const auto duration = std::chrono::steady_clock::now() - start;
+        phase_timings().record(name, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+};
+
+}
+
+#define AOC_PHASE_CONCAT_IMPL(a, b) a##b
+#define AOC_PHASE_CONCAT(a, b) AOC_PHASE_CONCAT_IMPL(a, b)
+// Times the rest of the enclosing scope as the given phase.
+#define AOC_PHASE(name) ::aocio::ScopedPhase AOC_PHASE_CONCAT(aoc_phase_, __LINE__) {name}
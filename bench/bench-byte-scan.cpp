@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include "../aoclib/byte-scan.hpp"
+
+/*
+    Throughput of for_each_byte_match (with the kernel the compiler targets) on a text-like buffer of 256 MiB by default
+    (or the first argument in MiB), for sets of 1 and 4 bytes and for a byte which does not occur (i.e. the kernel alone),
+    against a scalar loop, memchr and, as the memory bandwidth, a plain sum of the buffer's 64-bit words; the best of 3 runs each, in GB/s.
+*/
+
+#if defined(AOC_BYTE_SCAN_AVX2)
+constexpr std::string_view kernel = "AVX2";
+#elif defined(AOC_BYTE_SCAN_SSE2)
+constexpr std::string_view kernel = "SSE2";
+#else
+constexpr std::string_view kernel = "fallback";
+#endif
+
+template <typename Fn>
+static double best_gbps(std::size_t bytes, Fn&& f, int runs = 3)
+{
+    double best_ms = 1e300;
+    for (int i = 0; i < runs; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        best_ms = std::min(best_ms, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return static_cast<double>(bytes) / (best_ms * 1e6);
+}
+
+static void print_row(std::string_view name, double gbps)
+{
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2) << std::setw(10) << gbps << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t mib = argc > 1 ? std::max(1, std::atoi(argv[1])) : 256;
+    std::string text(mib << 20, ' ');
+    std::mt19937 rng {4};
+    for (char& c : text) { // Lines of about 40 characters with a few delimiters, like a puzzle input.
+        const unsigned r = rng() % 40;
+        c = r == 0 ? '\n' : r == 1 ? ',' : r == 2 ? ':' : static_cast<char>('a' + rng() % 26);
+    }
+    const std::string_view data {text};
+    int64_t sink = 0;
+
+    std::cout << mib << " MiB, kernel: " << kernel << "\n";
+    std::cout << std::left << std::setw(28) << "Scan" << std::right << std::setw(10) << "GB/s" << "\n";
+    print_row("sum of words (bandwidth)", best_gbps(data.size(), [&] {
+        uint64_t sum = 0;
+        for (std::size_t i = 0; i + 8 <= data.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data.data() + i, 8);
+            sum += word;
+        }
+        sink += static_cast<int64_t>(sum);
+    }));
+    print_row("memchr '\\n'", best_gbps(data.size(), [&] {
+        for (const char* p = data.data(), *end = p + data.size(); (p = static_cast<const char*>(std::memchr(p, '\n', end - p))); ++p) {
+            ++sink;
+        }
+    }));
+    print_row("scalar '\\n'", best_gbps(data.size(), [&] {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            sink += data[i] == '\n' ? static_cast<int64_t>(i) : 0;
+        }
+    }));
+    print_row("for_each_byte_match '\\n'", best_gbps(data.size(), [&] {
+        aocio::for_each_byte_match(data, aocio::ByteSet {"\n"}, [&sink](std::size_t i) { sink += static_cast<int64_t>(i); });
+    }));
+    print_row("for_each_byte_match, absent", best_gbps(data.size(), [&] { // The kernel alone, without any matches.
+        aocio::for_each_byte_match(data, aocio::ByteSet {"#"}, [&sink](std::size_t i) { sink += static_cast<int64_t>(i); });
+    }));
+    const aocio::ByteSet delims {"\n,: "};
+    print_row("scalar table, 4 bytes", best_gbps(data.size(), [&] {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            sink += delims.contains(data[i]) ? static_cast<int64_t>(i) : 0;
+        }
+    }));
+    print_row("for_each_byte_match, 4 bytes", best_gbps(data.size(), [&] {
+        aocio::for_each_byte_match(data, delims, [&sink](std::size_t i) { sink += static_cast<int64_t>(i); });
+    }));
+    return sink == 42 ? 1 : 0; // Keeps the results alive.
+}
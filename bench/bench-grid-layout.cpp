@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <vector>
+#include "../aoclib/grid.hpp"
+
+/*
+    Row-by-row and column-by-column passes over an n * n char grid (n = 16384 by default, or the first argument) 
+    through operator[], for every storage layout of Grid (cf. aoclib/grid.hpp); the minimum of 3 runs each. 
+    Non-square shapes are covered by the sizes of the storage, printed for a 2 * 1000000 grid. 
+*/
+
+template <typename Fn>
+static double min_ms(Fn&& f, int runs = 3)
+{
+    double best = 1e300;
+    for (int i = 0; i < runs; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+template <typename Layout>
+static int64_t bench(std::string_view name, int n)
+{
+    const aocutil::Grid<char, Layout> grid {n, n, std::vector<char>(static_cast<std::size_t>(n) * n, 1)};
+    int64_t sum = 0;
+    const double rows_ms = min_ms([&] {
+        for (int y = 0; y < n; ++y) {
+            for (int x = 0; x < n; ++x) {
+                sum += grid[{.x = x, .y = y}];
+            }
+        }
+    });
+    const double cols_ms = min_ms([&] {
+        for (int x = 0; x < n; ++x) {
+            for (int y = 0; y < n; ++y) {
+                sum += grid[{.x = x, .y = y}];
+            }
+        }
+    });
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(1) 
+              << std::setw(12) << rows_ms << std::setw(12) << cols_ms 
+              << std::setw(16) << Layout {2, 1000000}.size() << "\n";
+    return sum;
+}
+
+int main(int argc, char* argv[])
+{
+    const int n = argc > 1 ? std::max(1, std::atoi(argv[1])) : 16384;
+    std::cout << n << " * " << n << " grid\n";
+    std::cout << std::left << std::setw(12) << "Layout" << std::right << std::setw(12) << "Rows (ms)" << std::setw(12) << "Cols (ms)" 
+              << std::setw(16) << "2 * 1e6 size" << "\n";
+    int64_t sink = 0;
+    sink += bench<aocutil::RowMajor>("row-major", n);
+    sink += bench<aocutil::Tiled<>>("tiled<32>", n);
+    sink += bench<aocutil::Tiled<64>>("tiled<64>", n);
+    sink += bench<aocutil::Morton>("morton", n);
+    return sink == 42 ? 1 : 0; // Keeps the sums alive.
+}
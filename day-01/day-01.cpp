@@ -13,7 +13,11 @@
                       (edge case which would make this fail here: "twone" is both two and one)
 */
 
-static int64_t solve_part(const std::vector<std::string>& lines, int part_n)
+namespace day_01
+{
+
+template <typename Lines> // Lines: the lines of a MappedInput, or a LineReader.
+static int64_t solve_part(Lines&& lines, int part_n)
 {
     assert(part_n == 1 || part_n == 2);
     static constexpr int DIGIT_UNDEFINED = 12345;
@@ -64,18 +68,47 @@ static int64_t solve_part(const std::vector<std::string>& lines, int part_n)
     return total_sum;
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
-    bool file_read = aocio::file_getlines(AOC_INPUT_PATH, lines);
+    const std::vector<std::string_view> lines = aocio::split_lines(input); 
+    return {std::to_string(solve_part(lines, 1)), std::to_string(solve_part(lines, 2))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_01
+{
+
+static int run_day(int argc, char* argv[])
+{
+    const bool streamed = aocio::has_arg(argc, argv, "--stream"); // Read the input line by line with bounded memory. 
+    aocio::MappedInput input;
+    aocio::LineReader reader; 
+    bool file_read = aocio::timed_phase("load", [&] { return streamed ? reader.open(AOC_INPUT_PATH) : input.open(AOC_INPUT_PATH); });
     if (!file_read) {
         std::cerr << "Error: " << "File '" << AOC_INPUT_PATH << "' not found\n";
         return -1;
     }
 
-    std::cout << "Part 1: " <<  solve_part(lines, 1) << "\n";
-    std::cout << "Part 2: " <<  solve_part(lines, 2) << "\n";
+    if (streamed) {
+        std::cout << "Part 1: " <<  aocio::timed_phase("part1", [&] { return solve_part(reader, 1); }) << "\n";
+        reader.rewind(); 
+        std::cout << "Part 2: " <<  aocio::timed_phase("part2", [&] { return solve_part(reader, 2); }) << "\n";
+    } else {
+        std::cout << "Part 1: " <<  aocio::timed_phase("part1", [&] { return solve_part(input.lines(), 1); }) << "\n";
+        std::cout << "Part 2: " <<  aocio::timed_phase("part2", [&] { return solve_part(input.lines(), 2); }) << "\n";
+    }
 
     return 0;
 }
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, [argc, argv]() { return day_01::run_day(argc, argv); });
+}
+#endif
\ No newline at end of file
@@ -10,15 +10,26 @@
         - Part 2: 67363
 */
 
-int part_n(const std::vector<std::string> &games, const std::unordered_map<std::string, int> &game_limits, int part_n)
+namespace day_02
+{
+
+// 12 red cubes, 13 green cubes, and 14 blue cubes.
+const std::unordered_map<std::string, int> cube_limits {
+    {"red", 12}, 
+    {"green", 13},
+    {"blue", 14}
+};
+
+template <typename Lines> // Lines: e.g. a std::vector<std::string>, or a LineReader.
+int part_n(Lines&& games, const std::unordered_map<std::string, int> &game_limits, int part_n)
 {
     if (part_n != 1 && part_n != 2) {
         throw "Invalid part_n";
     }
 
     int solution_sum = 0; 
-    for (const std::string& game : games) {
-        std::istringstream is {game};
+    for (std::string_view game : games) {
+        std::istringstream is {std::string {game}};
         std::string game_str, colon; int game_id = -1; 
         is >> game_str >> game_id >> colon;
         if (is.fail() || game_str != "Game" || colon != ":" || game_id == -1) {
@@ -61,27 +72,35 @@ int part_n(const std::vector<std::string> &games, const std::unordered_map<std::
     return solution_sum;
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
+    const std::vector<std::string_view> lines = aocio::split_lines(input); 
+    return {std::to_string(part_n(lines, cube_limits, 1)), std::to_string(part_n(lines, cube_limits, 2))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_02
+{
+
+static int run_day(int argc, char* argv[])
+{
+    const bool streamed = aocio::has_arg(argc, argv, "--stream"); // Read the input line by line with bounded memory. 
     std::vector<std::string> lines;
+    aocio::LineReader reader; 
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return streamed ? reader.open(fname) : aocio::file_getlines(fname, lines); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return -1;
     }
 
-    // 12 red cubes, 13 green cubes, and 14 blue cubes.
-    std::unordered_map<std::string, int> game_limits {
-        {"red", 12}, 
-        {"green", 13},
-        {"blue", 14}
-    };
-
     try {
-        int p1 = part_n(lines, game_limits, 1);  
-        int p2 = part_n(lines, game_limits, 2);
+        int p1 = aocio::timed_phase("part1", [&] { return streamed ? part_n(reader, cube_limits, 1) : part_n(lines, cube_limits, 1); });
+        reader.rewind(); 
+        int p2 = aocio::timed_phase("part2", [&] { return streamed ? part_n(reader, cube_limits, 2) : part_n(lines, cube_limits, 2); });
         std::cout << "Part 1: " << p1 << "\n";
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
@@ -90,4 +109,13 @@ int main()
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, [argc, argv]() { return day_02::run_day(argc, argv); });
+}
+#endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include "../aoclib/aocio.hpp"
+#include "../aoclib/grid-stencil.hpp"
 
 /*
     Problem: https://adventofcode.com/2023/day/3
@@ -23,6 +24,9 @@
 
 */
 
+namespace day_03
+{
+
 static int digit_char_to_int(const char c)
 {
     if (!std::isdigit(c)) {
@@ -31,14 +35,7 @@ static int digit_char_to_int(const char c)
     return c - '0'; 
 }
 
-static bool idx_in_range(int num_rows, int num_cols, int row, int col)
-{
-    bool in_row = row >= 0 && row < num_rows; 
-    bool in_col = col >= 0 && col < num_cols;
-    return in_row && in_col; 
-}
-
-static bool adjacent_to_symbol(const std::vector<std::string>& lines, int row, int col)
+static bool adjacent_to_symbol(const std::vector<std::string_view>& lines, int row, int col)
 {
     if (row < 0 || row >= std::ssize(lines)) {
         throw "row-index out of range"; 
@@ -49,19 +46,15 @@ static bool adjacent_to_symbol(const std::vector<std::string>& lines, int row, i
     const int num_rows = lines.size();
     const int num_cols = lines.at(row).size(); 
 
-    for (int dx = -1; dx <= 1; ++dx) {
-        for (int dy = -1; dy <= 1; ++dy) {
-            if ((dx == 0 && dy == 0) || !idx_in_range(num_rows, num_cols, row + dy, col + dx)) {
-                continue;
-            } else if (lines.at(row + dy).at(col + dx) != '.' && !std::isdigit(lines.at(row + dy).at(col + dx)) ) {
-                return true; 
-            }
-        }
-    }
-    return false; 
+    bool adjacent = false; 
+    aocutil::for_each_neighbor_pos<aocutil::stencil::Moore8>(num_cols, num_rows, {.x = col, .y = row}, [&lines, &adjacent](const aocutil::Vec2<int>& adj) {
+        const char c = lines[adj.y][adj.x]; 
+        adjacent = adjacent || (c != '.' && !std::isdigit(c)); 
+    });
+    return adjacent; 
 }
 
-int part_one(const std::vector<std::string>& lines)
+int part_one(const std::vector<std::string_view>& lines)
 {
     int part_sum = 0; 
     for (int row = 0; row < std::ssize(lines); ++row) {
@@ -90,7 +83,7 @@ int part_one(const std::vector<std::string>& lines)
     return part_sum;
 }
 
-static int get_gear_ratio(const std::vector<std::string>& lines, int row, int col)
+static int get_gear_ratio(const std::vector<std::string_view>& lines, int row, int col)
 {
     if (row < 0 || row >= std::ssize(lines)) {
         throw "row-index out of range"; 
@@ -124,22 +117,14 @@ static int get_gear_ratio(const std::vector<std::string>& lines, int row, int co
     }; 
 
     std::vector<NumInfo> nums;  
-    for (int dx = -1; dx <= 1; ++dx) {
-        for (int dy = -1; dy <= 1; ++dy) {
-            if ((dx == 0 && dy == 0) || !idx_in_range(num_rows, num_cols, row + dy, col + dx)) {
-                continue;
-            }   
-            if (nums.size() > 2) { // Can't be a gear.
-                return 0;
-            }
-            if (std::isdigit(lines.at(row + dy).at(col + dx))) {
-                NumInfo num = parse_num(row + dy, col + dx);
-                if (std::find(nums.begin(), nums.end(), num) == nums.end()) { // Avoid duplicates. 
-                    nums.push_back(num);
-                }
+    aocutil::for_each_neighbor_pos<aocutil::stencil::Moore8>(num_cols, num_rows, {.x = col, .y = row}, [&](const aocutil::Vec2<int>& adj) {
+        if (nums.size() <= 2 && std::isdigit(lines[adj.y][adj.x])) { // More than two numbers can't be a gear.
+            NumInfo num = parse_num(adj.y, adj.x);
+            if (std::find(nums.begin(), nums.end(), num) == nums.end()) { // Avoid duplicates. 
+                nums.push_back(num);
             }
         }
-    }
+    });
 
     if (nums.size() == 2) { // It is in fact a gear. 
         return nums.at(0).num * nums.at(1).num; 
@@ -148,7 +133,7 @@ static int get_gear_ratio(const std::vector<std::string>& lines, int row, int co
     }
 }
 
-int64_t part_two(const std::vector<std::string>& lines)
+int64_t part_two(const std::vector<std::string_view>& lines)
 {
     int64_t gear_ratio_sum = 0; 
     for (int row = 0; row < std::ssize(lines); ++row) {
@@ -162,21 +147,34 @@ int64_t part_two(const std::vector<std::string>& lines)
     return gear_ratio_sum;
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::vector<std::string_view> lines = aocio::split_lines(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_03
+{
+
+static int run_day()
+{
+    aocio::MappedInput input;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return -1;
     }
+    const std::vector<std::string_view>& lines = input.lines();
 
     try {
-        int p1 = part_one(lines);  
+        int p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
@@ -184,4 +182,13 @@ int main()
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_03::run_day);
+}
+#endif
\ No newline at end of file
@@ -12,34 +12,52 @@
 
 */
 
-int part_one(const std::vector<std::string>& lines)
+namespace day_04
+{
+
+struct Card {
+    int id; 
+    std::vector<int> winning_numbers, numbers; 
+};
+
+// Parses "Card <id>: <winning numbers> | <numbers>" (reusing card's vectors). 
+void parse_card(std::string_view line, Card& card)
+{
+    const std::size_t colon_idx = line.find(':'); 
+    const std::size_t bar_idx = line.find('|'); 
+    if (colon_idx == std::string_view::npos || bar_idx == std::string_view::npos || bar_idx < colon_idx || !line.starts_with("Card")) {
+        throw "Invalid card line";
+    }
+
+    const auto card_id = aocio::parse_num(line.substr(4, colon_idx - 4)); 
+    if (!card_id) {
+        throw "Invalid Card id";
+    }
+    card.id = card_id.value(); 
+
+    const std::string_view winning_nums_str = line.substr(colon_idx + 1, bar_idx - colon_idx - 1); 
+    const std::string_view nums_str = line.substr(bar_idx + 1); 
+    auto only_nums = [](std::string_view str) {return str.find_first_not_of("0123456789 ") == std::string_view::npos;}; // extract_all_ints skips anything else. 
+    const bool nums_valid = only_nums(winning_nums_str) && only_nums(nums_str) 
+                            && aocio::extract_all_ints(winning_nums_str, card.winning_numbers) && aocio::extract_all_ints(nums_str, card.numbers); 
+    if (!nums_valid) {
+        throw "Invalid number token";
+    }
+}
+
+template <typename Lines> // Lines: the lines of a MappedInput, or a LineReader.
+int part_one(Lines&& lines)
 {
     int cards_total_points = 0; 
 
-    for (const std::string& line : lines ) {
-        std::vector<std::string> card_tokens; 
-        aocio::line_tokenise(line, " \t|:", "|:", card_tokens);
-        if (card_tokens.size() <= 3 || card_tokens.at(2) != ":") {
-            throw "Invalid card line";
-        }
+    Card card; 
+    for (std::string_view line : lines) {
+        parse_card(line, card); 
 
         int card_points = 0; 
-        std::unordered_set<int> winning_numbers; 
-        bool section_winning_numbers = true; 
-
-        for (auto tok_i = card_tokens.begin() + 3; tok_i != card_tokens.end(); ++tok_i) {
-            if (*tok_i == "|") {
-                section_winning_numbers = false; 
-                continue;
-            } 
-            size_t num_read = 0; 
-            int num = std::stoi(*tok_i, &num_read, 10);
-            if (!num_read) {
-                throw "Invalid number token";
-            }
-            if (section_winning_numbers) {
-                winning_numbers.insert(num);
-            } else if (winning_numbers.contains(num)) {
+        const std::unordered_set<int> winning_numbers (card.winning_numbers.begin(), card.winning_numbers.end()); 
+        for (int num : card.numbers) {
+            if (winning_numbers.contains(num)) {
                 card_points = !card_points ? 1 : card_points * 2; 
             }
         }
@@ -49,7 +67,8 @@ int part_one(const std::vector<std::string>& lines)
     return cards_total_points;
 }
 
-int part_two(const std::vector<std::string>& lines)
+template <typename Lines>
+int part_two(Lines&& lines)
 {
     int cards_total = 0; 
 
@@ -63,36 +82,16 @@ int part_two(const std::vector<std::string>& lines)
         }
     };
 
-    for (const std::string& line : lines ) {
-        std::vector<std::string> card_tokens; 
-        aocio::line_tokenise(line, " \t|:", "|:", card_tokens);
-        if (card_tokens.size() <= 3 || card_tokens.at(0) != "Card" || card_tokens.at(2) != ":") {
-            throw "Invalid card line";
-        }
-
-        size_t num_read_card_id = 0; 
-        const int card_id = std::stoi(card_tokens.at(1), &num_read_card_id);
-        if (!num_read_card_id) {
-            throw "Invalid Card id";
-        }
+    Card card; 
+    for (std::string_view line : lines) {
+        parse_card(line, card); 
+        const int card_id = card.id; 
         update_card_count(card_id, 1);
 
         int matching = 0; 
-        std::unordered_set<int> winning_numbers; 
-        bool section_winning_numbers = true; 
-        for (auto tok_i = card_tokens.begin() + 3; tok_i != card_tokens.end(); ++tok_i) {
-            if (*tok_i == "|") {
-                section_winning_numbers = false; 
-                continue;
-            } 
-            size_t num_read = 0; 
-            int num = std::stoi(*tok_i, &num_read);
-            if (!num_read) {
-                throw "Invalid number token";
-            }
-            if (section_winning_numbers) {
-                winning_numbers.insert(num);
-            } else if (winning_numbers.contains(num)) {
+        const std::unordered_set<int> winning_numbers (card.winning_numbers.begin(), card.winning_numbers.end()); 
+        for (int num : card.numbers) {
+            if (winning_numbers.contains(num)) {
                 ++matching; // Don't multiply by two like in part 1. 
             }
         }
@@ -100,30 +99,44 @@ int part_two(const std::vector<std::string>& lines)
         for (int i = 1; i <= matching; ++i) {
             update_card_count(card_id + i, card_count[card_id]);
         }
-    }
-
-    for (const auto& [id, cnt] : card_count) {
-        cards_total += cnt;
+        // The count of the current card is final now (only later cards are updated), so we only keep the counts of the next cards. 
+        cards_total += card_count[card_id]; 
+        card_count.erase(card_id); 
     }
 
     return cards_total;
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::vector<std::string_view> lines = aocio::split_lines(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_04
+{
+
+static int run_day(int argc, char* argv[])
+{
+    const bool streamed = aocio::has_arg(argc, argv, "--stream"); // Read the input line by line with bounded memory. 
+    aocio::MappedInput input;
+    aocio::LineReader reader; 
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return streamed ? reader.open(fname) : input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return -1;
     }    
 
     try {
-        int p1 = part_one(lines);  
+        int p1 = aocio::timed_phase("part1", [&] { return streamed ? part_one(reader) : part_one(input.lines()); });
         std::cout << "Part 1: " << p1 << "\n";
-        int p2 = part_two(lines);
+        reader.rewind(); 
+        int p2 = aocio::timed_phase("part2", [&] { return streamed ? part_two(reader) : part_two(input.lines()); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
@@ -131,4 +144,13 @@ int main()
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, [argc, argv]() { return day_04::run_day(argc, argv); });
+}
+#endif
\ No newline at end of file
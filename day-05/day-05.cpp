@@ -14,6 +14,9 @@
         - Part 2: silly bug that I only fixed by looking at my solution for part 1
 */
 
+namespace day_05
+{
+
 struct IDRange {
     int64_t start_id, size; 
 
@@ -61,48 +64,41 @@ struct CatMapping {
     std::vector <IDRange> src_ranges, dst_ranges; 
 };
 
+constexpr aocio::Delims almanac_delims {" \t-"}; 
+
 int64_t part_one(const std::vector<std::string>& lines)
 {
     std::unordered_map<std::string, CatMapping> categories; 
     std::vector<int64_t> seeds;
     
-    auto parse_num = [](const std::string& tok) -> int64_t {
-        size_t num_read = 0; 
-        int64_t id = std::stoll(tok, &num_read);
-        if (num_read == 0) {
-            throw "Invalid token: expected number";
-        }
-        return id; 
-    };
-
     bool in_map = false; 
     std::string src_cat_name = "";
     std::string dest_cat_name = "";
+    std::vector<std::string_view> tokens; 
+    std::vector<int64_t> nums; 
     for (const std::string& line : lines) {
         if (!line.size()) {
             in_map = false; 
         }
 
-        std::vector<std::string> tokens; 
-        aocio::line_tokenise(line, " \t-", "", tokens);
-        
         if (in_map)  {
-            if (tokens.size() != 3) {
+            if (!aocio::extract_all_ints(line, nums) || nums.size() != 3) {
                 throw "Amount of numbers within mapping section must be 3 (dst, src, range)";
             }
-            int64_t dst_id = parse_num(tokens.at(0)); 
-            int64_t src_id = parse_num(tokens.at(1));
-            int64_t range_n = parse_num(tokens.at(2));
+            int64_t dst_id = nums.at(0); 
+            int64_t src_id = nums.at(1);
+            int64_t range_n = nums.at(2);
             categories[src_cat_name].src_ranges.push_back({.start_id=src_id, .size=range_n}); 
             categories[src_cat_name].dst_ranges.push_back({.start_id=dst_id, .size=range_n}); 
             continue;
         }
 
+        aocio::line_tokenise(line, almanac_delims, tokens);
         for (int tok_n = 0; tok_n < std::ssize(tokens); ++tok_n) {
-            std::string tok = tokens[tok_n];
+            std::string_view tok = tokens[tok_n];
             if (tok == "seeds:") {
-                for (int i = tok_n + 1; i < std::ssize(tokens); ++i) {
-                    seeds.push_back(parse_num(tokens[i]));
+                if (!aocio::extract_all_ints(line, seeds)) {
+                    throw "Invalid token: expected number";
                 }
                 break; 
             } 
@@ -163,45 +159,39 @@ int64_t part_two(const std::vector<std::string>& lines)
     std::unordered_map<std::string, CatMapping> categories; 
     std::vector<IDRange> seed_ranges;
     
-    auto parse_num = [](const std::string& tok) -> int64_t {
-        size_t num_read = 0; 
-        int64_t id = std::stoll(tok, &num_read);
-        if (num_read == 0) {
-            throw "Invalid token: expected number";
-        }
-        return id; 
-    };
-
     bool in_map = false; 
     std::string src_cat_name = "";
     std::string dest_cat_name = "";
+    std::vector<std::string_view> tokens; 
+    std::vector<int64_t> nums; 
     for (const std::string& line : lines) {
         if (!line.size()) {
             in_map = false; 
         }
 
-        std::vector<std::string> tokens; 
-        aocio::line_tokenise(line, " \t-", "", tokens);
-        
         if (in_map)  {
-            if (tokens.size() != 3) {
+            if (!aocio::extract_all_ints(line, nums) || nums.size() != 3) {
                 throw "Amount of numbers within mapping section must be 3 (dst, src, range)";
             }
-            int64_t dst_id = parse_num(tokens.at(0)); 
-            int64_t src_id = parse_num(tokens.at(1));
-            int64_t range_n = parse_num(tokens.at(2));
+            int64_t dst_id = nums.at(0); 
+            int64_t src_id = nums.at(1);
+            int64_t range_n = nums.at(2);
             categories[src_cat_name].src_ranges.push_back({.start_id=src_id, .size=range_n}); 
             categories[src_cat_name].dst_ranges.push_back({.start_id=dst_id, .size=range_n}); 
             continue;
         }
 
+        aocio::line_tokenise(line, almanac_delims, tokens);
         for (int tok_n = 0; tok_n < std::ssize(tokens); ++tok_n) {
-            std::string tok = tokens[tok_n];
+            std::string_view tok = tokens[tok_n];
             if (tok == "seeds:") { // Part 2: Parse ranges.
-                assert((std::ssize(tokens) - (tok_n + 1)) % 2 == 0);
-                for (int i = tok_n + 1; i < std::ssize(tokens) - 1; i+=2) {
-                    int64_t src_id = parse_num(tokens.at(i)); 
-                    int64_t size = parse_num(tokens.at(i+1));
+                if (!aocio::extract_all_ints(line, nums)) {
+                    throw "Invalid token: expected number";
+                }
+                assert(std::ssize(nums) % 2 == 0);
+                for (int i = 0; i < std::ssize(nums) - 1; i+=2) {
+                    int64_t src_id = nums.at(i); 
+                    int64_t size = nums.at(i+1);
                     seed_ranges.push_back({.start_id=src_id, .size=size});
                 }
                 break; 
@@ -280,21 +270,33 @@ int64_t part_two(const std::vector<std::string>& lines)
     }
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
+{
+    const std::vector<std::string> lines = aocio::split_lines<std::string>(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_05
+{
+
+static int run_day()
 {
-    aocio::print_day();
     std::vector<std::string> lines;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return aocio::file_getlines(fname, lines); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
 
     try {
-        int64_t p1 = part_one(lines);  
+        int64_t p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
@@ -302,4 +304,13 @@ int main()
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_05::run_day);
+}
+#endif
\ No newline at end of file
@@ -13,38 +13,49 @@
       - There's a closed form solution (see Part 2).
 */
 
+namespace day_06
+{
+
 struct Race {
     int64_t duration_ms, record_dist_mm; 
 };
 
-void parse_races(std::vector<Race> &result, const std::vector<std::string>& lines)
+// Extracts the numbers of the "Time:" and "Distance:" lines. 
+template <typename Lines> // Lines: the lines of a MappedInput, or a LineReader.
+void parse_race_numbers(Lines&& lines, std::vector<int64_t>& times, std::vector<int64_t>& dists)
 {
-    assert(lines.size() == 2);
-
-    std::vector<std::string> toks_time, toks_dist; 
-    aocio::line_tokenise(lines.at(0), " \t", "", toks_time);
-    assert(toks_time.at(0) == "Time:");
-
-    aocio::line_tokenise(lines.at(1), " \t", "", toks_dist);
-    assert(toks_dist.at(0) == "Distance:");
-
-    assert(toks_time.size() == toks_dist.size() && toks_time.size() > 1); 
-
-    auto parse_num = [](const std::string& tok) -> int64_t {
-        size_t num_read = 0; 
-        int64_t n = std::stoll(tok, &num_read);
-        if (num_read == 0) {
-            throw "Invalid token: expected number";
+    int line_idx = 0; 
+    for (std::string_view line : lines) {
+        if (line_idx == 0) {
+            assert(line.starts_with("Time:"));
+            if (!aocio::extract_all_ints(line, times)) {
+                throw "Invalid token: expected number";
+            }
+        } else if (line_idx == 1) {
+            assert(line.starts_with("Distance:"));
+            if (!aocio::extract_all_ints(line, dists)) {
+                throw "Invalid token: expected number";
+            }
         }
-        return n; 
-    };
+        ++line_idx; 
+    }
+    assert(line_idx == 2);
+    assert(times.size() == dists.size() && times.size() > 0); 
+}
 
-    for (size_t i = 1; i < toks_time.size(); ++i) {
-        result.emplace_back(Race {.duration_ms = parse_num(toks_time.at(i)), .record_dist_mm = parse_num(toks_dist.at(i))});
+template <typename Lines>
+void parse_races(std::vector<Race> &result, Lines&& lines)
+{
+    std::vector<int64_t> times, dists; 
+    parse_race_numbers(lines, times, dists); 
+
+    for (size_t i = 0; i < times.size(); ++i) {
+        result.emplace_back(Race {.duration_ms = times.at(i), .record_dist_mm = dists.at(i)});
     }
 }
 
-int64_t part_one(const std::vector<std::string>& lines)
+template <typename Lines>
+int64_t part_one(Lines&& lines)
 {
     std::vector<Race> races; 
     parse_races(races, lines);
@@ -66,27 +77,11 @@ int64_t part_one(const std::vector<std::string>& lines)
     return win_combinations;
 }
 
-Race parse_races_part_two(const std::vector<std::string>& lines)
+template <typename Lines>
+Race parse_races_part_two(Lines&& lines)
 {
-    assert(lines.size() == 2);
-
-    std::vector<std::string> toks_time, toks_dist; 
-    aocio::line_tokenise(lines.at(0), " \t", "", toks_time);
-    assert(toks_time.at(0) == "Time:");
-
-    aocio::line_tokenise(lines.at(1), " \t", "", toks_dist);
-    assert(toks_dist.at(0) == "Distance:");
-    
-    assert(toks_time.size() == toks_dist.size() && toks_time.size() > 1); 
-
-    auto parse_num = [](const std::string& tok) -> int64_t {
-        size_t num_read = 0; 
-        int64_t n = std::stoll(tok, &num_read);
-        if (num_read == 0) {
-            throw "Invalid token: expected number";
-        }
-        return n; 
-    };
+    std::vector<int64_t> times, dists; 
+    parse_race_numbers(lines, times, dists); 
 
     auto pow_10 = [](int64_t exp) -> int64_t {
         int64_t res = 1; 
@@ -106,9 +101,9 @@ Race parse_races_part_two(const std::vector<std::string>& lines)
     };
 
     Race r {.duration_ms = 0, .record_dist_mm = 0};
-    for (size_t i = 1; i < toks_time.size(); ++i) {
-        int64_t duration_digit = parse_num(toks_time.at(i));
-        int64_t dist_digit = parse_num(toks_dist.at(i));
+    for (size_t i = 0; i < times.size(); ++i) {
+        int64_t duration_digit = times.at(i);
+        int64_t dist_digit = dists.at(i);
         r.duration_ms = r.duration_ms * pow_10(num_digits(duration_digit)) + duration_digit; 
         r.record_dist_mm = r.record_dist_mm * pow_10(num_digits(dist_digit)) + dist_digit; 
     }
@@ -117,7 +112,8 @@ Race parse_races_part_two(const std::vector<std::string>& lines)
 
 constexpr bool part_two_use_brute_force = false; 
 
-int64_t part_two(const std::vector<std::string>& lines)
+template <typename Lines>
+int64_t part_two(Lines&& lines)
 {
     Race r = parse_races_part_two(lines); 
     int64_t win_combinations = 0;
@@ -159,21 +155,36 @@ int64_t part_two(const std::vector<std::string>& lines)
     return win_combinations;
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::vector<std::string_view> lines = aocio::split_lines(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_06
+{
+
+static int run_day(int argc, char* argv[])
+{
+    const bool streamed = aocio::has_arg(argc, argv, "--stream"); // Read the input line by line with bounded memory. 
+    aocio::MappedInput input;
+    aocio::LineReader reader; 
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return streamed ? reader.open(fname) : input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
 
     try {
-        int64_t p1 = part_one(lines);  
+        int64_t p1 = aocio::timed_phase("part1", [&] { return streamed ? part_one(reader) : part_one(input.lines()); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        reader.rewind(); 
+        int64_t p2 = aocio::timed_phase("part2", [&] { return streamed ? part_two(reader) : part_two(input.lines()); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
@@ -181,4 +192,13 @@ int main()
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, [argc, argv]() { return day_06::run_day(argc, argv); });
+}
+#endif
\ No newline at end of file
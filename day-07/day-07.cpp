@@ -2,6 +2,7 @@
 #include <numeric>
 #include <array>
 #include "../aoclib/aocio.hpp"
+#include "../aoclib/input-cache.hpp"
 
 /*
     Problem: https://adventofcode.com/2023/day/7
@@ -14,6 +15,9 @@
         - I missed the bold "J cards are now the weakest" in the problem description of part 2 and wasted lots of time...
 */
 
+namespace day_07
+{
+
 constexpr std::array<char, 13> card_labels = {'2', '3', '4', '5', '6', '7', '8', '9', 'T', 'J', 'Q', 'K', 'A'};
 enum class HandType {NumTypes = 7, FiveOfKind=6, FourOfKind=5, FullHouse=4, ThreeOfKind=3, TwoPair=2, OnePair=1, HighCard=0};
 const std::array<std::string, static_cast<size_t>(HandType::NumTypes)> hand_type_to_str {"High Card", "One Pair", "Two Pair", "Three of a kind", "Full House", "Four of a kind", "Five of a kind"};
@@ -35,7 +39,7 @@ public:
     int bid; 
     bool use_jokers; 
 
-    Hand(const std::string &card_str, int bid, bool use_jokers = false) : bid{bid}, use_jokers{use_jokers} 
+    Hand(std::string_view card_str, int bid, bool use_jokers = false) : bid{bid}, use_jokers{use_jokers} 
     {
         assert(card_str.size() == 5);
         int i = 0; 
@@ -178,22 +182,25 @@ public:
     }
 }; 
 
-void parse_hands(std::vector<Hand> &result, const std::vector<std::string>& lines, bool use_jokers = false)
+template <typename Lines> // Lines: the lines of a MappedInput, or a LineReader.
+void parse_hands(std::vector<Hand> &result, Lines&& lines)
 {
-
-    for (auto &line : lines) {
-        std::vector<std::string> toks; 
-        aocio::line_tokenise(line, " \t", "", toks); 
+    constexpr aocio::Delims hand_delims {" \t"}; 
+    std::vector<std::string_view> toks; 
+    for (std::string_view line : lines) {
+        aocio::line_tokenise(line, hand_delims, toks); 
         assert(toks.size() == 2); 
         int bid = aocio::parse_num(toks.at(1)).value(); 
-        result.emplace_back(Hand(toks.at(0), bid, use_jokers));
+        result.emplace_back(Hand(toks.at(0), bid));
     }
 }
 
-int part_one(const std::vector<std::string>& lines, bool use_jokers = false)
+// Sorts its copy of the hands.
+int total_winnings(std::vector<Hand> hands, bool use_jokers)
 {
-    std::vector<Hand> hands; 
-    parse_hands(hands, lines, use_jokers); 
+    for (Hand& hand : hands) {
+        hand.use_jokers = use_jokers; 
+    }
     std::sort(hands.begin(), hands.end()); 
 
     int total_winnings = 0; 
@@ -205,26 +212,68 @@ int part_one(const std::vector<std::string>& lines, bool use_jokers = false)
     return total_winnings;
 }
 
-int part_two(const std::vector<std::string>& lines)
+// Change it whenever Hand or parse_hands change (cf. aoclib/input-cache.hpp). 
+constexpr std::string_view hands_cache_schema = "day-07 hands v1"; 
+
+// Uses the cached hands of a previous run if the input did not change (cf. aoclib/input-cache.hpp). 
+std::vector<Hand> load_hands(const aocio::MappedInput& input, std::string_view fname)
 {
-   return part_one(lines, true);
+    const std::string cache_path = aocio::cache_path(fname, "hands"); 
+    const uint64_t input_hash = aocio::hash_bytes(input.contents()); 
+    aocio::InputCache cache; 
+    if (cache.open(cache_path, input_hash, hands_cache_schema)) {
+        if (const auto cached = cache.get<Hand>(0)) {
+            return std::vector<Hand>(cached->begin(), cached->end()); 
+        }
+    }
+
+    std::vector<Hand> hands; 
+    parse_hands(hands, input.lines()); 
+    aocio::CacheWriter writer; 
+    writer.add(hands); 
+    writer.write(cache_path, input_hash, hands_cache_schema); 
+    return hands; 
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp); the hands are parsed once and shared by both parts. 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    std::vector<Hand> hands; 
+    parse_hands(hands, aocio::split_lines(input)); 
+    return {std::to_string(total_winnings(hands, false)), std::to_string(total_winnings(hands, true))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_07
+{
+
+static int run_day(int argc, char* argv[])
+{
+    const bool streamed = aocio::has_arg(argc, argv, "--stream"); // Read the input line by line with bounded memory. 
+    aocio::MappedInput input;
+    aocio::LineReader reader; 
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return streamed ? reader.open(fname) : input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
 
     try {
-        int p1 = part_one(lines);  
+        std::vector<Hand> hands; 
+        {
+            AOC_PHASE("parse"); 
+            if (streamed) {
+                parse_hands(hands, reader); 
+            } else {
+                hands = load_hands(input, fname); 
+            }
+        }
+        int p1 = aocio::timed_phase("part1", [&] { return total_winnings(hands, false); });
         std::cout << "Part 1: " << p1 << "\n";
-        int p2 = part_two(lines);
+        int p2 = aocio::timed_phase("part2", [&] { return total_winnings(hands, true); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
@@ -232,4 +281,13 @@ int main()
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, [argc, argv]() { return day_07::run_day(argc, argv); });
+}
+#endif
\ No newline at end of file
@@ -16,27 +16,33 @@
           In theory, those cycles could be longer etc., which would make this solution incorrect; cf. assertions l. 126-127
 */
 
+namespace day_08
+{
+
 using StrPair = std::pair<std::string, std::string>; 
 using AdjacencyMap = std::unordered_map<std::string, StrPair>; 
 
-void parse_graph(const std::vector<std::string>& lines, AdjacencyMap &adj_map_res, std::string &instruction_res)
+constexpr aocio::Delims node_delims {" \t=(),"}; 
+
+void parse_graph(const std::vector<std::string_view>& lines, AdjacencyMap &adj_map_res, std::string &instruction_res)
 {
+    std::vector<std::string_view> toks; 
     for (auto &line : lines) {
-        std::vector<std::string> toks; 
-        aocio::line_tokenise(line, " \t=(),", "", toks); 
+        aocio::line_tokenise(line, node_delims, toks); 
         if (toks.size() == 1) { 
             instruction_res = toks.at(0); 
         } else if (toks.size() == 0) {
             continue; 
         } else {
             assert(toks.size() == 3);
-            assert(!adj_map_res.contains(toks.at(0))); 
-            adj_map_res.insert({toks.at(0), StrPair{toks.at(1), toks.at(2)}}); 
+            std::string node {toks.at(0)}; 
+            assert(!adj_map_res.contains(node)); 
+            adj_map_res.insert({node, StrPair{toks.at(1), toks.at(2)}}); 
         }
     }
 }
 
-int part_one(const std::vector<std::string>& lines)
+int part_one(const std::vector<std::string_view>& lines)
 {
     AdjacencyMap adj_map; 
     std::string direction_instrs; 
@@ -58,27 +64,28 @@ int part_one(const std::vector<std::string>& lines)
     return instr_cnt; 
 }
 
-void parse_graph_two(const std::vector<std::string>& lines, AdjacencyMap& adj_map_res, std::string& instr_res, std::vector<std::string>& start_nodes)
+void parse_graph_two(const std::vector<std::string_view>& lines, AdjacencyMap& adj_map_res, std::string& instr_res, std::vector<std::string>& start_nodes)
 {
+    std::vector<std::string_view> toks; 
     for (auto &line : lines) {
-        std::vector<std::string> toks; 
-        aocio::line_tokenise(line, " \t=(),", "", toks); 
+        aocio::line_tokenise(line, node_delims, toks); 
         if (toks.size() == 1) { 
             instr_res = toks.at(0); 
         } else if (toks.size() == 0) {
             continue; 
         } else {
             assert(toks.size() == 3);
-            assert(!adj_map_res.contains(toks.at(0))); 
-            if (toks.at(0).back() == 'A') {
-                start_nodes.push_back(toks.at(0)); 
+            std::string node {toks.at(0)}; 
+            assert(!adj_map_res.contains(node)); 
+            if (node.back() == 'A') {
+                start_nodes.push_back(node); 
             } 
-            adj_map_res.insert({toks.at(0), StrPair{toks.at(1), toks.at(2)}}); 
+            adj_map_res.insert({node, StrPair{toks.at(1), toks.at(2)}}); 
         }
     }
 }
 
-int64_t part_two(const std::vector<std::string>& lines)
+int64_t part_two(const std::vector<std::string_view>& lines)
 {
     AdjacencyMap adj_map; 
     std::string direction_instrs; 
@@ -131,24 +138,46 @@ int64_t part_two(const std::vector<std::string>& lines)
     return steps;
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::vector<std::string_view> lines = aocio::split_lines(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_08
+{
+
+static int run_day()
+{
+    aocio::MappedInput input;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
+    const std::vector<std::string_view>& lines = input.lines();
     try {
-        int p1 = part_one(lines);  
+        int p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_08::run_day);
+}
+#endif
\ No newline at end of file
@@ -14,75 +14,99 @@
         - Learned about std::adjacent_difference and std::back_inserter
 */
 
-void parse_histories(const std::vector<std::string>& lines, std::vector<std::vector<int>> &result)
+namespace day_09
 {
-    for (auto &line : lines) {
-        std::vector<std::string> toks; 
-        aocio::line_tokenise(line, " \t", "", toks); 
-        std::vector<int> history; 
-        for (const auto &tok : toks) {
-            history.push_back(aocio::parse_num(tok).value());
-       }
-       result.push_back(history); 
-    }
-}
 
-int part_one(const std::vector<std::string>& lines, bool backwards = false)
+// Returns the next (or, if backwards, the previous) value of the history. 
+int extrapolate(const std::vector<int>& history, bool backwards)
 {
-    std::vector<std::vector<int>> histories; 
-    parse_histories(lines, histories); 
-
-    int result = 0; 
-    for (const std::vector<int>& history : histories) {
-        std::vector<std::vector<int>> diffs; 
-        diffs.push_back(history); 
-        do {
-            const std::vector<int>& prev = diffs.back(); 
-            assert(prev.size() > 1); 
-            std::vector<int> diff; 
-            std::adjacent_difference(prev.begin(), prev.end(), std::back_inserter(diff)); 
-            diff.erase(diff.begin());
-            assert(diff.size() == prev.size() - 1); 
-            diffs.push_back(diff); 
-        } while (!std::all_of(diffs.back().begin(), diffs.back().end(), [](int a) -> bool {return a == 0;}));
+    std::vector<std::vector<int>> diffs; 
+    diffs.push_back(history); 
+    do {
+        const std::vector<int>& prev = diffs.back(); 
+        assert(prev.size() > 1); 
+        std::vector<int> diff; 
+        std::adjacent_difference(prev.begin(), prev.end(), std::back_inserter(diff)); 
+        diff.erase(diff.begin());
+        assert(diff.size() == prev.size() - 1); 
+        diffs.push_back(diff); 
+    } while (!std::all_of(diffs.back().begin(), diffs.back().end(), [](int a) -> bool {return a == 0;}));
 
-        for (auto d = diffs.rbegin(), prev = diffs.rend(); d != diffs.rend(); prev = d++) {
-            if (d == diffs.rbegin()) {
-                d->push_back(0); 
-            } else {
-                // Notice: We still push next to the end of the vector if backwards == true.
-                int next = !backwards ? d->back() + prev->back() : d->front() - prev->back(); 
-                d->push_back(next); 
-            } 
+    for (auto d = diffs.rbegin(), prev = diffs.rend(); d != diffs.rend(); prev = d++) {
+        if (d == diffs.rbegin()) {
+            d->push_back(0); 
+        } else {
+            // Notice: We still push next to the end of the vector if backwards == true.
+            int next = !backwards ? d->back() + prev->back() : d->front() - prev->back(); 
+            d->push_back(next); 
         } 
-        result += diffs.front().back(); 
+    } 
+    return diffs.front().back(); 
+}
+
+// Every history is extrapolated right after parsing it, so only one line is kept in memory at a time. 
+template <typename Lines> // Lines: the lines of a MappedInput, or a LineReader.
+int part_one(Lines&& lines, bool backwards = false)
+{
+    int result = 0; 
+    std::vector<int> history; 
+    for (std::string_view line : lines) {
+        if (!aocio::extract_all_ints(line, history)) {
+            throw "Invalid history value";
+        }
+        result += extrapolate(history, backwards); 
     }
     return result; 
 }
 
-int part_two(const std::vector<std::string>& lines)
+template <typename Lines>
+int part_two(Lines&& lines)
 {
     return part_one(lines, true);
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::vector<std::string_view> lines = aocio::split_lines(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_09
+{
+
+static int run_day(int argc, char* argv[])
+{
+    const bool streamed = aocio::has_arg(argc, argv, "--stream"); // Read the input line by line with bounded memory. 
+    aocio::MappedInput input;
+    aocio::LineReader reader; 
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return streamed ? reader.open(fname) : input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
     try {
-        int p1 = part_one(lines);  
+        int p1 = aocio::timed_phase("part1", [&] { return streamed ? part_one(reader) : part_one(input.lines()); });
         std::cout << "Part 1: " << p1 << "\n";
-        int p2 = part_two(lines);
+        reader.rewind(); 
+        int p2 = aocio::timed_phase("part2", [&] { return streamed ? part_two(reader) : part_two(input.lines()); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, [argc, argv]() { return day_09::run_day(argc, argv); });
+}
+#endif
\ No newline at end of file
@@ -1,10 +1,10 @@
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <numeric>
 #include <array>
 #include <queue>
 #include "../aoclib/aocio.hpp"
+#include "../aoclib/grid-bfs.hpp"
 
 /*
     Problem: https://adventofcode.com/2023/day/10
@@ -29,6 +29,9 @@
                   But I'm thankful it worked.
 */
 
+namespace day_10
+{
+
 struct GridPos {
     int x, y; 
 };
@@ -421,78 +424,29 @@ int part_two(const std::vector<std::string>& lines)
 
     g.grid = double_res_grid; 
 
-    // Find start vertices on the edge of the grid (only those which don't fall on inbetween-tiles).
-    std::vector<std::string> start_verts; 
-    for (int y = 0; y < std::ssize(g.grid); ++y) {
-        if (y == 0 || y == std::ssize(g.grid) - 1) { 
-            for (int x = 0; x < std::ssize(g.grid.at(y)); ++x) {
-                if (g.grid.at(y).at(x) == GRID_UNVISITED_SYM) {
-                    std::string vert = gridpos_to_vertname(GridPos{.x=x, .y=y}); 
-                    start_verts.emplace_back(vert); 
-                }
+    // Find start tiles on the edge of the grid (only those which don't fall on inbetween-tiles).
+    const int width = std::ssize(g.grid.at(0)), height = std::ssize(g.grid); 
+    std::vector<aocutil::Vec2<int>> start_tiles; 
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const bool on_edge = y == 0 || y == height - 1 || x == 0 || x == width - 1; 
+            if (on_edge && g.grid.at(y).at(x) == GRID_UNVISITED_SYM) {
+                start_tiles.push_back(aocutil::Vec2<int>{.x = x, .y = y}); 
             }
-            continue; 
-        }
-        if (g.grid.at(y).front() == GRID_UNVISITED_SYM) {
-            std::string vert = gridpos_to_vertname(GridPos{.x=0, .y=y}); 
-            start_verts.emplace_back(vert); 
-        }
-        if (g.grid.at(y).back() == GRID_UNVISITED_SYM) {
-            std::string vert = gridpos_to_vertname(GridPos{.x=static_cast<int>(g.grid.at(y).size()) - 1, .y=y}); 
-            start_verts.emplace_back(vert); 
         }
     }
 
-    // Flood fill (this time it's a DFS, but a BFS with a queue would also work.) 
-    std::unordered_set<std::string> visited; 
-    const char REACHABLE_SYM = 'o';
-    for (const auto& s_vert: start_verts) {
-        if (visited.contains(s_vert)) {
-            continue; 
-        } 
-        std::stack<std::string> vert_stack; 
-        vert_stack.push(s_vert); 
-
-        while (!vert_stack.empty()) {
-            std::string vert = vert_stack.top();
-            vert_stack.pop(); 
-            GridPos vpos = vertname_to_gridpos(vert); 
-
-            if (!visited.contains(vert)) {
-                visited.insert(vert); 
-                if (g.grid.at(vpos.y).at(vpos.x) == GRID_UNVISITED_SYM) { // Only modify on whole tiles.
-                    g.grid.at(vpos.y).at(vpos.x) = REACHABLE_SYM; 
-                } 
-            } else {
-                continue;
-            }
-
-            for (Direction d : all_dirs) { // Find neighbors.
-                GridPos adj_pos; 
-                std::string adj_vert; 
-                auto adj_sym = g.grid_peek(vpos, d, adj_pos); 
-                if (adj_sym) {
-                    adj_vert = gridpos_to_vertname(adj_pos); 
-                    if (visited.contains(adj_vert)) {
-                        continue; 
-                    } else {
-                        bool wall = adj_sym.value() == '|' || adj_sym.value() == '-' || adj_sym.value() == 'L' || adj_sym.value() == 'J'|| adj_sym.value() == '7' || adj_sym.value() == 'F'; 
-                        if (!wall) {
-                            vert_stack.push(adj_vert);  
-                            if (g.grid.at(vpos.y).at(vpos.x) == GRID_UNVISITED_SYM) { // Only modify grid for whole tiles, not inbetween-tiles.
-                                g.grid.at(vpos.y).at(vpos.x) = REACHABLE_SYM; 
-                            } 
-                        }
-                    }
-                }
-            }
-        }
-    }
+    // Flood fill (a multi-source BFS from all start tiles at once). 
+    const aocutil::Grid<int32_t> dist = aocutil::grid_bfs(width, height, start_tiles, [&g](const aocutil::Vec2<int>& pos) {
+        const char sym = g.grid[pos.y][pos.x]; 
+        const bool wall = sym == '|' || sym == '-' || sym == 'L' || sym == 'J'|| sym == '7' || sym == 'F'; 
+        return !wall; 
+    }); 
 
     int count_unreachable = 0; 
-    for (int y = 0; y < std::ssize(g.grid); y+= 2) { // Only sample whole tiles, not inbetween-tiles. 
-        for (int x = 0; x < std::ssize(g.grid.at(y)); x+= 2) {
-            if (g.grid.at(y).at(x) == GRID_UNVISITED_SYM) {
+    for (int y = 0; y < height; y+= 2) { // Only sample whole tiles, not inbetween-tiles. 
+        for (int x = 0; x < width; x+= 2) {
+            if (g.grid.at(y).at(x) == GRID_UNVISITED_SYM && dist.get(x, y) == aocutil::bfs_unreachable) {
                 ++count_unreachable; 
             }
         }
@@ -508,24 +462,45 @@ int part_two(const std::vector<std::string>& lines)
     return count_unreachable; 
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
+{
+    const std::vector<std::string> lines = aocio::split_lines<std::string>(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_10
+{
+
+static int run_day()
 {
-    aocio::print_day();
     std::vector<std::string> lines;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return aocio::file_getlines(fname, lines); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
     try {
-        int p1 = part_one(lines);  
+        int p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int p2 = part_two(lines);
+        int p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_10::run_day);
+}
+#endif
\ No newline at end of file
@@ -12,6 +12,9 @@
           the "smart" way turned out to be easier for both parts. 
 */
 
+namespace day_11
+{
+
 class Grid 
 {
 public:
@@ -117,24 +120,45 @@ int64_t part_two(const std::vector<std::string>& lines)
     return part_one(lines, 1000'000);
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
+{
+    const std::vector<std::string> lines = aocio::split_lines<std::string>(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_11
+{
+
+static int run_day()
 {
-    aocio::print_day();
     std::vector<std::string> lines;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return aocio::file_getlines(fname, lines); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
     try {
-        int64_t p1 = part_one(lines);  
+        int64_t p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_11::run_day);
+}
+#endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../aoclib/aocio.hpp"
+#include "../aoclib/input-cache.hpp"
 #include "../aoclib/lru-cache.hpp"
 
 /*
@@ -13,6 +14,9 @@
           But it should use less memory for smaller lru sizes, which is cool. 
 */
 
+namespace day_12
+{
+
 using aocutil::LRUCache; 
 
 struct SpringRecord {
@@ -49,17 +53,18 @@ struct SpringRecord {
     }
 };
 
-void parse_spring_records(const std::vector<std::string>& lines, std::vector<SpringRecord> &result)
+void parse_spring_records(const std::vector<std::string_view>& lines, std::vector<SpringRecord> &result)
 {
+    constexpr aocio::Delims record_delims {" \t"}; 
+    constexpr aocio::Delims group_delims {","}; 
+    std::vector<std::string_view> toks, str_nums; 
     for (const auto &line : lines) {
         SpringRecord sr; 
-        std::vector<std::string> toks; 
-        aocio::line_tokenise(line, " \t", "", toks);
+        aocio::line_tokenise(line, record_delims, toks);
         assert(toks.size() == 2); 
         sr.condition = toks.at(0);
 
-        std::vector<std::string> str_nums; 
-        aocio::line_tokenise(toks.at(1), ",", "", str_nums);
+        aocio::line_tokenise(toks.at(1), group_delims, str_nums);
         for (const auto& str : str_nums) {
             sr.damaged_groups.push_back(aocio::parse_num(str).value()); 
         }
@@ -74,10 +79,12 @@ struct State {
     bool operator==(const State&) const = default;
 }; 
 
+}
+
 template<>
-struct std::hash<State>
+struct std::hash<day_12::State>
 {
-    std::size_t operator()(const State& s) const noexcept
+    std::size_t operator()(const day_12::State& s) const noexcept
     {
         std::size_t h1 = std::hash<char>{}(s.cur_sym); 
         std::size_t h2 = std::hash<int>{}(s.str_idx); 
@@ -87,6 +94,9 @@ struct std::hash<State>
     }
 };
 
+namespace day_12
+{
+
 template <std::size_t LRU_SIZE>
 int64_t find_arrangements(const SpringRecord &s, LRUCache<State, int64_t, LRU_SIZE>& lru, int dmg_group_idx = 0, int str_idx = 0, int dmg_spring_len = 0, char cur_sym = ' ')
 {    
@@ -165,11 +175,8 @@ constexpr std::size_t lru_size = 256;
 using LRUCache_FindArr = LRUCache<State, int64_t, lru_size>; 
 LRUCache_FindArr lru = LRUCache_FindArr(); 
 
-int64_t part_one(const std::vector<std::string>& lines)
+int64_t part_one(const std::vector<SpringRecord>& springs)
 {
-    std::vector<SpringRecord> springs; 
-    parse_spring_records(lines, springs);
-
     int64_t total = 0; 
     for (auto& s : springs) {
         lru.clear(); 
@@ -180,11 +187,8 @@ int64_t part_one(const std::vector<std::string>& lines)
     return total; 
 }
 
-int64_t part_two(const std::vector<std::string>& lines)
+int64_t part_two(std::vector<SpringRecord> springs)
 {
-    std::vector<SpringRecord> springs; 
-    parse_spring_records(lines, springs);
-    
     int64_t total = 0; 
     for (auto& s :springs) {
         s.unfold();
@@ -195,24 +199,108 @@ int64_t part_two(const std::vector<std::string>& lines)
     return total; 
 }
 
-int main()
+// The input cache only takes flat arrays, so the conditions and damaged groups of all records are concatenated.
+struct RecordExtent {
+    uint32_t condition_len, num_groups; 
+};
+
+// Change it whenever RecordExtent, the layout of the sections or parse_spring_records change (cf. aoclib/input-cache.hpp). 
+constexpr std::string_view records_cache_schema = "day-12 spring-records v1"; 
+
+// False if the sections don't fit together (i.e. the cache has to be rebuilt). 
+static bool read_cached_records(const aocio::InputCache& cache, std::vector<SpringRecord>& records)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const auto conditions = cache.get<char>(0); 
+    const auto groups = cache.get<int>(1); 
+    const auto extents = cache.get<RecordExtent>(2); 
+    if (!conditions || !groups || !extents) {
+        return false; 
+    }
+    std::size_t cond_idx = 0, group_idx = 0; 
+    for (const RecordExtent& ext : *extents) {
+        if (cond_idx + ext.condition_len > conditions->size() || group_idx + ext.num_groups > groups->size()) {
+            records.clear(); 
+            return false; 
+        }
+        SpringRecord& sr = records.emplace_back(); 
+        sr.condition.assign(conditions->data() + cond_idx, ext.condition_len); 
+        sr.damaged_groups.assign(groups->begin() + group_idx, groups->begin() + group_idx + ext.num_groups); 
+        cond_idx += ext.condition_len; 
+        group_idx += ext.num_groups; 
+    }
+    return true; 
+}
+
+// Uses the cached records of a previous run if the input did not change (cf. aoclib/input-cache.hpp). 
+std::vector<SpringRecord> load_spring_records(const aocio::MappedInput& input, std::string_view fname)
+{
+    const std::string cache_path = aocio::cache_path(fname, "spring-records"); 
+    const uint64_t input_hash = aocio::hash_bytes(input.contents()); 
+    std::vector<SpringRecord> records; 
+
+    aocio::InputCache cache; 
+    if (cache.open(cache_path, input_hash, records_cache_schema) && read_cached_records(cache, records)) {
+        return records; 
+    }
+
+    parse_spring_records(input.lines(), records); 
+    std::vector<char> conditions; 
+    std::vector<int> groups; 
+    std::vector<RecordExtent> extents; 
+    for (const SpringRecord& sr : records) {
+        conditions.insert(conditions.end(), sr.condition.begin(), sr.condition.end()); 
+        groups.insert(groups.end(), sr.damaged_groups.begin(), sr.damaged_groups.end()); 
+        extents.push_back(RecordExtent {.condition_len = static_cast<uint32_t>(sr.condition.size()), .num_groups = static_cast<uint32_t>(sr.damaged_groups.size())}); 
+    }
+    aocio::CacheWriter writer; 
+    writer.add(conditions); 
+    writer.add(groups); 
+    writer.add(extents); 
+    writer.write(cache_path, input_hash, records_cache_schema); 
+    return records; 
+}
+
+// Used by the multi-day runner (cf. aoc/days.hpp); the spring records are parsed once and shared by both parts. 
+std::pair<std::string, std::string> solve(std::string_view input)
+{
+    std::vector<SpringRecord> springs; 
+    parse_spring_records(aocio::split_lines(input), springs); 
+    return {std::to_string(part_one(springs)), std::to_string(part_two(springs))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_12
+{
+
+static int run_day()
+{
+    aocio::MappedInput input;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
     try {
-        int64_t p1 = part_one(lines);  
+        const std::vector<SpringRecord> springs = aocio::timed_phase("parse", [&] { return load_spring_records(input, fname); }); 
+        int64_t p1 = aocio::timed_phase("part1", [&] { return part_one(springs); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(springs); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_12::run_day);
+}
+#endif
\ No newline at end of file
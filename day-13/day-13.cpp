@@ -1,6 +1,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include "../aoclib/aocio.hpp"
+#include "../aoclib/grid.hpp"
 
 /*
     Problem: https://adventofcode.com/2023/day/13
@@ -17,23 +18,32 @@
           equal to the pattern's number of rows/cols minus one. 
 */
 
+namespace day_13
+{
+
 enum class Axis {Vertical, Horizontal};
 
 struct Pattern 
 {
-    std::vector<std::string> lines; 
+    aocutil::Grid<char> grid; 
+    aocutil::Grid<char> transposed; // The columns of grid as rows. 
+
+    Pattern(std::span<const std::string> lines) : grid{lines}, transposed{grid}
+    {
+        transposed.transpose(); 
+    }
 
     std::optional<int> reflection(Axis axis, bool find_smudge = false) const
     {
         std::unordered_map<int, int> mirror_starts;
 
-        auto line_mirror_start = [&mirror_starts](const std::string& line) {
+        auto line_mirror_start = [&mirror_starts](std::span<const char> line) {
             for (int left = 0; left < std::ssize(line) - 1; ++left) {
                 int max_delta = std::min(left+1, std::abs((int)std::ssize(line) - 1 - left));
                 bool is_mirrored = true; 
                 for (int d = 1; d <= max_delta; ++d) {
-                    char left_sym = line.at(left + 1 - d); 
-                    char right_sym = line.at(left + d);
+                    char left_sym = line[left + 1 - d]; 
+                    char right_sym = line[left + d];
                     if (left_sym != right_sym) {
                         is_mirrored = false; 
                         break;
@@ -50,71 +60,43 @@ struct Pattern
             }
         }; 
 
-        switch (axis) {
-        case Axis::Vertical:
-            for (const auto& line: lines) {
-                line_mirror_start(line); 
-            }
-            for (const auto& [mirror_start, cnt] : mirror_starts) {
-                if (find_smudge && cnt == std::ssize(lines) - 1) {
-                    return mirror_start; 
-                } else if (!find_smudge && cnt == std::ssize(lines)) {
-                    return mirror_start;
-                }
-            }
-            break;
-
-        case Axis::Horizontal:
-            for (int col = 0; col < std::ssize(lines.at(0)); ++col) {
-                std::string column = "";
-                for (int row = 0; row < std::ssize(lines); ++row) {
-                    column.push_back(lines.at(row).at(col)); 
-                }
-                line_mirror_start(column); 
-            }
-            for (const auto& [mirror_start, cnt] : mirror_starts) {
-                if (find_smudge && cnt == std::ssize(lines.at(0)) - 1) {
-                    return mirror_start;
-                } else if (!find_smudge && cnt == std::ssize(lines.at(0))) {
-                    return mirror_start; 
-                }
-            }
-            break;
-
-        default:
+        if (axis != Axis::Vertical && axis != Axis::Horizontal) {
             throw "Not an axis";
-            break;
+        }
+        // A horizontal mirror line is a vertical one of the transposed pattern. 
+        const aocutil::Grid<char>& lines = axis == Axis::Vertical ? grid : transposed; 
+        for (int y = 0; y < lines.height(); ++y) {
+            line_mirror_start(lines.row(y)); 
+        }
+        for (const auto& [mirror_start, cnt] : mirror_starts) {
+            if (find_smudge && cnt == lines.height() - 1) {
+                return mirror_start; 
+            } else if (!find_smudge && cnt == lines.height()) {
+                return mirror_start;
+            }
         }
         return {};
     }
 
     friend std::ostream& operator<<(std::ostream& os, const Pattern& p)
     {
-        for (const auto& line : p.lines) {
-            for (char c : line) {
-                os << c;
-            }
-            os << "\n";
-        }
-        return os;
+        return os << p.grid;
     }
 }; 
 
 void parse_patterns(const std::vector<std::string>& lines, std::vector<Pattern>& result)
 {
-    Pattern pat; 
-    for (const auto& line: lines) {
-        if (line.size() == 0) {
-            if (pat.lines.size() != 0) {
-                result.push_back(pat);
+    auto pat_begin = lines.begin(); 
+    for (auto line = lines.begin(); line != lines.end(); ++line) {
+        if (line->size() == 0) {
+            if (line != pat_begin) {
+                result.emplace_back(std::span<const std::string> {pat_begin, line});
             }
-            pat = {}; 
-        } else {
-            pat.lines.push_back(line);
+            pat_begin = std::next(line); 
         }
     }
-    if (pat.lines.size() != 0) {
-        result.push_back(pat);
+    if (pat_begin != lines.end()) {
+        result.emplace_back(std::span<const std::string> {pat_begin, lines.end()});
     }
 }
 
@@ -144,24 +126,45 @@ int64_t part_two(const std::vector<std::string>& lines)
     return part_one(lines, true);
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
+{
+    const std::vector<std::string> lines = aocio::split_lines<std::string>(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_13
+{
+
+static int run_day()
 {
-    aocio::print_day();
     std::vector<std::string> lines;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return aocio::file_getlines(fname, lines); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
     try {
-        int64_t p1 = part_one(lines);  
+        int64_t p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_13::run_day);
+}
+#endif
\ No newline at end of file
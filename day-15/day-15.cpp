@@ -12,6 +12,9 @@
         - Part 2: Naive solution, but it still runs instantly. 
 */
 
+namespace day_15
+{
+
 bool is_ascii(char c)
 {
     return c >= 0 && c <= 127; 
@@ -31,7 +34,7 @@ uint8_t hash(std::string_view s)
     return h; 
 }
 
-int part_one(const std::vector<std::string>& lines)
+int part_one(const std::vector<std::string_view>& lines)
 {
     int total_hash = 0; 
     std::string_view line = lines.at(0);
@@ -96,7 +99,7 @@ struct Box
     }
 }; 
 
-int part_two(const std::vector<std::string>& lines)
+int part_two(const std::vector<std::string_view>& lines)
 {
     std::array<Box, 256> boxes; 
     for (size_t i = 0; i < boxes.size(); ++i) {
@@ -139,24 +142,46 @@ int part_two(const std::vector<std::string>& lines)
     return std::accumulate(boxes.begin(), boxes.end(), 0, [](int total, const Box& box) {return total + box.calc_focusing_power();});
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::vector<std::string_view> lines = aocio::split_lines(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_15
+{
+
+static int run_day()
+{
+    aocio::MappedInput input;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
+    const std::vector<std::string_view>& lines = input.lines();
     try {
-        int p1 = part_one(lines);  
+        int p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int p2 = part_two(lines);
+        int p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const char* err) {
         std::cerr << "Error: " << err << "\n";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_15::run_day);
+}
+#endif
\ No newline at end of file
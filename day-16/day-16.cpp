@@ -1,7 +1,6 @@
-#include <unordered_set>
-#include <stack>
 #include "../aoclib/aocio.hpp"
 #include "../aoclib/grid.hpp"
+#include "../aoclib/grid-pool.hpp"
 
 /*
     Problem: https://adventofcode.com/2023/day/16
@@ -13,6 +12,9 @@
         - Implemented a templated grid class with custom random_access_iterators as an exercise. That was fun!
 */
 
+namespace day_16
+{
+
 using namespace aocutil; 
 
 struct Beam {
@@ -20,78 +22,66 @@ struct Beam {
     bool operator==(const Beam&) const = default;
 };
 
-template<>
-struct std::hash<Beam> {
-    std::size_t operator()(const Beam& b) const noexcept
-    {
-        std::size_t h1 = std::hash<Vec2<int>>{}(b.pos); 
-        std::size_t h2 = std::hash<Vec2<int>>{}(b.dir); 
-        return h1 ^ (h2 << 1); // cf. https://en.cppreference.com/w/cpp/utility/hash (last retrieved 2024-06-17)
-    }
+// Scratch memory of calculate_energized, reused by all calls (so they don't allocate after the first one). 
+struct EnergizeScratch {
+    ScratchGridPool<uint8_t> grids; // Per tile, the directions of the beams which passed it (cf. dir_bit). 
+    std::vector<Beam> beams; 
 };
 
-using BeamSet = std::unordered_set<Beam>; 
-
-const std::ostream& operator<<(std::ostream& os, const BeamSet& bs)
-{
-    if (bs.size()) {
-        return os << "#";
-    } else {
-        return os << ".";
-    }
-}
-
 constexpr Vec2<int> dir_right = {.x = 1, .y = 0};
 constexpr Vec2<int> dir_left = {.x = -1, .y = 0};
 constexpr Vec2<int> dir_up = {.x = 0, .y = -1};
 constexpr Vec2<int> dir_down = {.x = 0, .y = 1};
 
-void parse_grid(const std::vector<std::string>& lines, Grid<char>& grid)
+constexpr char outside = ' '; // Sentinel of the border around the grid. 
+
+constexpr uint8_t dir_bit(const Vec2<int>& dir)
 {
-    for (const auto& line: lines) {
-        if (line.size()) {
-            grid.push_row(line);
-        }
-    }
+    return dir == dir_right ? 1 : dir == dir_left ? 2 : dir == dir_up ? 4 : 8; 
 }
 
-int calculate_energized(const Grid<char>& grid, Beam start_beam)
+// With a border of one tile, so a beam which left the grid is simply on an outside tile. 
+Grid<char> parse_grid(const std::vector<std::string>& lines)
 {
-    Grid<BeamSet> energised_grid; 
-    for (int y = 0; y < grid.height(); ++y) {
-        std::vector<BeamSet> row(grid.width(), BeamSet()); 
-        energised_grid.push_row(row);
-    }
+    return Grid<char> {aocio::trim_empty_lines(lines), 1, outside}; 
+}
+
+int calculate_energized(const Grid<char>& grid, Beam start_beam, EnergizeScratch& scratch)
+{
+    const ScratchGridPool<uint8_t>::Lease energised_grid = scratch.grids.acquire(grid.width(), grid.height(), 0); 
+    int num_energised = 0; 
 
-    std::stack<Beam> beams; // We follow the beam depth-first since we use a stack here (breadth-first if we used a queue).
-    beams.push(start_beam);
+    std::vector<Beam>& beams = scratch.beams; // We follow the beam depth-first since we use a stack here (breadth-first if we used a queue).
+    beams.clear(); 
+    beams.push_back(start_beam);
 
     while (beams.size()) {
-        Beam b = beams.top();
-        beams.pop();
-        auto sym = grid.try_get(b.pos); 
+        Beam b = beams.back();
+        beams.pop_back();
+        const char sym = grid[b.pos]; 
         
-        if (!sym) { // The beam left the grid. 
+        if (sym == outside) { // The beam left the grid. 
             continue; 
         }
 
-        if (energised_grid.at(b.pos).contains(b)) { // The tile was already visited by the same beam. 
+        uint8_t& beam_dirs = energised_grid->touch(b.pos); 
+        if (beam_dirs & dir_bit(b.dir)) { // The tile was already visited by the same beam. 
             continue; 
-        } else {
-            energised_grid.at(b.pos).insert(b);
-        }
+        } 
+        num_energised += beam_dirs == 0; 
+        beam_dirs |= dir_bit(b.dir); 
 
-        switch (sym.value())
+        switch (sym)
         {
         case '.': {
             Beam new_b = {.dir = b.dir, .pos = b.pos + b.dir};
-            beams.push(new_b);
+            beams.push_back(new_b);
             break;
         }
 
         case '/':
         case '\\': {
-            const bool is_mirror_right = sym.value() == '/';
+            const bool is_mirror_right = sym == '/';
             if (b.dir == dir_right) { 
                 b.dir = is_mirror_right ? dir_up : dir_down; 
             } else if (b.dir == dir_left) {
@@ -102,19 +92,19 @@ int calculate_energized(const Grid<char>& grid, Beam start_beam)
                 b.dir = is_mirror_right ? dir_left : dir_right; 
             }
             b.pos = b.pos + b.dir;
-            beams.push(b);
+            beams.push_back(b);
             break; 
         }
 
         case '|': {
             if (b.dir == dir_down || b.dir == dir_up) {
                 b.pos = b.pos + b.dir;
-                beams.push(b);
+                beams.push_back(b);
             } else {
                 Beam b_up = {.pos = b.pos, .dir = dir_up};
                 Beam b_down = {.pos = b.pos, .dir = dir_down};
-                beams.push(b_up);
-                beams.push(b_down);
+                beams.push_back(b_up);
+                beams.push_back(b_down);
             }
             break;
         }
@@ -122,12 +112,12 @@ int calculate_energized(const Grid<char>& grid, Beam start_beam)
         case '-': {
             if (b.dir == dir_left || b.dir == dir_right) {
                 b.pos = b.pos + b.dir;
-                beams.push(b);
+                beams.push_back(b);
             } else {
                 Beam b_left = {.pos = b.pos, .dir = dir_left};
                 Beam b_right = {.pos = b.pos, .dir = dir_right};
-                beams.push(b_left);
-                beams.push(b_right);
+                beams.push_back(b_left);
+                beams.push_back(b_right);
             }
             break;
         }
@@ -137,21 +127,19 @@ int calculate_energized(const Grid<char>& grid, Beam start_beam)
             break;
         }
     }
-    // std::cout << energised_grid << "\n";
-    return std::count_if(energised_grid.cbegin(), energised_grid.cend(), [](const BeamSet& bs) {return bs.size() > 0;});
+    return num_energised;
 }
 
 int part_one(const std::vector<std::string>& lines)
 {
-    Grid<char> grid; 
-    parse_grid(lines, grid);
-    return calculate_energized(grid, Beam{.pos={0, 0}, .dir = dir_right});
+    const Grid<char> grid = parse_grid(lines);
+    EnergizeScratch scratch; 
+    return calculate_energized(grid, Beam{.pos={0, 0}, .dir = dir_right}, scratch);
 }
 
 int part_two(const std::vector<std::string>& lines)
 {
-    Grid<char> grid;
-    parse_grid(lines, grid);
+    const Grid<char> grid = parse_grid(lines);
 
     std::vector<Beam> start_beams; 
     for (int x = 0; x < grid.width(); ++x) { // Top and bottom edge. 
@@ -167,31 +155,53 @@ int part_two(const std::vector<std::string>& lines)
         start_beams.push_back(b_right);
     }
 
+    EnergizeScratch scratch; 
     int max_energized = 0; 
     for (const Beam& beam : start_beams) {
-        max_energized = std::max(calculate_energized(grid, beam), max_energized);
+        max_energized = std::max(calculate_energized(grid, beam, scratch), max_energized);
     }
     return max_energized; 
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
+{
+    const std::vector<std::string> lines = aocio::split_lines<std::string>(input); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_16
+{
+
+static int run_day()
 {
-    aocio::print_day();
     std::vector<std::string> lines;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return aocio::file_getlines(fname, lines); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
     try {
-        int p1 = part_one(lines);  
+        int p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int p2 = part_two(lines);
+        int p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const std::exception& err) {
         std::cerr << "Error: " << err.what() << "\n";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_16::run_day);
+}
+#endif
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <array>
 #include "../aoclib/aocio.hpp"
 #include "../aoclib/grid.hpp"
+#include "../aoclib/grid-soa.hpp"
+#include "../aoclib/input-cache.hpp"
 
 /*
     Problem: https://adventofcode.com/2023/day/17
@@ -21,13 +23,16 @@
           std::priority_queue
 */
 
+namespace day_17
+{
+
 using aocutil::Vec2; 
 using aocutil::Direction; 
 using aocutil::dir_to_vec2; 
 using aocutil::dir_get_left_right; 
 using aocutil::Grid; 
 
-void parse_grid(const std::vector<std::string>& lines, Grid<int>& grid)
+void parse_grid(const std::vector<std::string_view>& lines, Grid<int>& grid)
 {
     for (const auto& line: lines) {
         if (line.size()) {
@@ -52,49 +57,28 @@ constexpr int max_straight_steps_limit = 10;
 constexpr int num_directions = 4; 
 constexpr int max_states_per_cell = num_directions * (max_straight_steps_limit + 1); 
 
-struct CostGridCell 
+// The index of the plane of the cost grid for the state (i.e. per direction and number of straight steps, 0 to max_straight_steps_limit). 
+constexpr int calc_state_idx(const State& s)
 {
-private: 
-    std::array<int, max_states_per_cell> id_to_cost;
-
-    constexpr int calc_state_idx(const State& s) const
-    {
-        int idx = 0; 
-        if (s.dir == Direction::Up) {
-            idx = 1 * max_straight_steps_limit; 
-        } else if (s.dir == Direction::Right) {
-            idx = 2 * max_straight_steps_limit; 
-        } else if (s.dir == Direction::Down) {
-            idx = 3 * max_straight_steps_limit;
-        } else {
-            assert(s.dir == Direction::Left); 
-        }
-        idx += s.straight_cnt; 
-        assert(idx >= 0); 
-        assert(idx < std::ssize(id_to_cost));
-        return idx; 
-    }
-
-public:
-    CostGridCell() 
-    {
-        for (auto& cost : id_to_cost) {
-            cost = infinity;  
-        }
+    constexpr int states_per_dir = max_straight_steps_limit + 1; 
+    int idx = 0; 
+    if (s.dir == Direction::Up) {
+        idx = 1 * states_per_dir; 
+    } else if (s.dir == Direction::Right) {
+        idx = 2 * states_per_dir; 
+    } else if (s.dir == Direction::Down) {
+        idx = 3 * states_per_dir;
+    } else {
+        assert(s.dir == Direction::Left); 
     }
+    idx += s.straight_cnt; 
+    assert(idx >= 0); 
+    assert(idx < max_states_per_cell);
+    return idx; 
+}
 
-    void save_cost(const State& s, int cost)
-    {
-        int idx = calc_state_idx(s);
-        id_to_cost.at(idx) = cost; 
-    }
-
-    int get_cost(const State& s) const
-    {
-        int idx = calc_state_idx(s); 
-        return id_to_cost.at(idx); 
-    }
-};
+// The cost of every state, one plane per kind of state (cf. calc_state_idx), so the relaxations only touch the planes they need. 
+using CostGrid = aocutil::UniformSoAGrid<int, max_states_per_cell>; 
 
 std::array<State, 3> find_adjacent(const Grid<int>& grid, const State& s, int min_steps, int max_steps, int &size)
 {   
@@ -158,18 +142,15 @@ int find_shortest_path(const Grid<int>& grid, int min_straight_steps = 0, int ma
     queue.push(CostStatePair{heuristic(start_r.pos, end_pos), start_r});
     queue.push(CostStatePair{heuristic(start_d.pos, end_pos), start_d});
 
-    Grid<CostGridCell> cost_grid;
-    for (int y = 0; y < grid.height(); ++y) {
-        cost_grid.push_row(std::vector<CostGridCell>(grid.width(), CostGridCell()));
-    }
-    cost_grid.at(start_r.pos).save_cost(start_r, 0);
-    cost_grid.at(start_d.pos).save_cost(start_d, 0);
+    CostGrid cost_grid {grid.width(), grid.height(), infinity};
+    cost_grid.plane(calc_state_idx(start_r)).at(start_r.pos) = 0;
+    cost_grid.plane(calc_state_idx(start_d)).at(start_d.pos) = 0;
     
     while (!queue.empty()) {
         const auto [priority, current] = queue.top();
         queue.pop();
         
-        int current_cost = cost_grid.at(current.pos).get_cost(current); 
+        int current_cost = cost_grid.plane(calc_state_idx(current))[current.pos]; 
 
         if (current.pos == end_pos && current.straight_cnt >= min_straight_steps) {
             return current_cost;
@@ -184,9 +165,9 @@ int find_shortest_path(const Grid<int>& grid, int min_straight_steps = 0, int ma
         auto neighbors = find_adjacent(grid, current, min_straight_steps, max_straight_steps, num_neighbors);
         for (int i = 0; i < num_neighbors; ++i) {
             State adj = neighbors[i]; 
-            int adj_cost = cost_grid.at(adj.pos).get_cost(adj);
+            int& adj_cost = cost_grid.plane(calc_state_idx(adj))[adj.pos];
             if (int new_cost = current_cost + grid.at(adj.pos); new_cost < adj_cost) { // Must not be new_cost <= adj_cost
-                cost_grid.at(adj.pos).save_cost(adj, new_cost);
+                adj_cost = new_cost;
                 assert(new_cost != infinity);
                 queue.emplace(new_cost + heuristic(adj.pos, end_pos), adj);
             }
@@ -195,38 +176,84 @@ int find_shortest_path(const Grid<int>& grid, int min_straight_steps = 0, int ma
     return infinity;
 }
 
-int part_one(const std::vector<std::string>& lines)
+int part_one(const Grid<int>& grid)
 {
-    Grid<int> grid; 
-    parse_grid(lines, grid); 
     return find_shortest_path(grid, 0, 3);
 }
 
-int part_two(const std::vector<std::string>& lines)
+int part_two(const Grid<int>& grid)
 {
-    Grid<int> grid;
-    parse_grid(lines, grid);
     return find_shortest_path(grid, 4, 10);
 }
 
-int main()
+// Change it whenever the sections or parse_grid change (cf. aoclib/input-cache.hpp). 
+constexpr std::string_view grid_cache_schema = "day-17 grid v1"; 
+
+// Uses the cached grid of a previous run if the input did not change (cf. aoclib/input-cache.hpp). 
+Grid<int> load_grid(const aocio::MappedInput& input, std::string_view fname)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::string cache_path = aocio::cache_path(fname, "grid"); 
+    const uint64_t input_hash = aocio::hash_bytes(input.contents()); 
+    aocio::InputCache cache; 
+    if (cache.open(cache_path, input_hash, grid_cache_schema)) {
+        const auto size = cache.get<int>(0); 
+        const auto cells = cache.get<int>(1); 
+        if (size && cells && size->size() == 2 && (*size)[0] >= 0 && (*size)[1] >= 0 
+            && cells->size() == static_cast<std::size_t>((*size)[0]) * (*size)[1]) {
+            return Grid<int> {(*size)[0], (*size)[1], *cells}; 
+        }
+    }
+
+    Grid<int> grid; 
+    parse_grid(input.lines(), grid); 
+    aocio::CacheWriter writer; 
+    writer.add(std::vector<int> {grid.width(), grid.height()}); 
+    writer.add(std::vector<int>(grid.cbegin(), grid.cend())); 
+    writer.write(cache_path, input_hash, grid_cache_schema); 
+    return grid; 
+}
+
+// Used by the multi-day runner (cf. aoc/days.hpp); the grid is parsed once and shared by both parts. 
+std::pair<std::string, std::string> solve(std::string_view input)
+{
+    Grid<int> grid; 
+    parse_grid(aocio::split_lines(input), grid); 
+    return {std::to_string(part_one(grid)), std::to_string(part_two(grid))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_17
+{
+
+static int run_day()
+{
+    aocio::MappedInput input;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
     try {
-        int p1 = part_one(lines);  
+        const Grid<int> grid = aocio::timed_phase("parse", [&] { return load_grid(input, fname); }); 
+        int p1 = aocio::timed_phase("part1", [&] { return part_one(grid); });
         std::cout << "Part 1: " << p1 << "\n";
-        int p2 = part_two(lines);
+        int p2 = aocio::timed_phase("part2", [&] { return part_two(grid); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const std::exception& err) {
         std::cerr << "Error: " << err.what() << "\n";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_17::run_day);
+}
+#endif
\ No newline at end of file
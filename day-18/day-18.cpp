@@ -1,5 +1,6 @@
 #include "../aoclib/aocio.hpp"
 #include "../aoclib/vec.hpp"
+#include "../aoclib/input-cache.hpp"
 
 /*
     Problem: https://adventofcode.com/2023/day/18
@@ -19,98 +20,220 @@
          but I don't understand how Pick's theorem works. 
 */
 
+namespace day_18
+{
+
 using Vec2 = typename aocutil::Vec2<int64_t>; 
 
-std::pair<Vec2, Vec2> parse_edge(const std::string& line, Vec2& prev_end_vert, int64_t& boundary_points, bool part_2 = false)
-{
-    std::pair<Vec2, Vec2> edge; 
+struct Edge {
+    Vec2 first, second; 
+};
+
+struct DigStep {
+    char dir; 
+    int64_t steps; 
+    std::string_view colour; // The six hex digits without '(#' and ')'. 
+};
 
-    std::vector<std::string> toks; 
-    aocio::line_tokenise(line, " ", "", toks);
+DigStep parse_dig_step(std::string_view line)
+{
+    constexpr aocio::Delims edge_delims {" "}; 
+    std::vector<std::string_view> toks; 
+    aocio::line_tokenise(line, edge_delims, toks);
     assert(toks.size() == 3); 
 
-    std::string dir = toks.at(0);
-    int64_t steps = aocio::parse_num(toks.at(1)).value(); 
+    std::string_view clr_str = toks.at(2); 
+    // Remove leading '(#' and trailing ')'
+    clr_str = clr_str.substr(2, clr_str.size() - 3); 
+    return DigStep {.dir = toks.at(0).at(0), .steps = aocio::parse_num(toks.at(1)).value(), .colour = clr_str}; 
+}
 
-    if (part_2) {
-        std::string clr_str = toks.at(2); 
-        // Remove leading '(#' and trailing ')'
-        clr_str =  clr_str.substr(2, clr_str.size()); 
-        clr_str = clr_str.substr(0, clr_str.size() - 1); 
-        // Now we have a six digit hex number; the first five digits represent the steps.
-        steps = aocio::parse_hex(clr_str.substr(0, 5)).value();  
-        // The last digit is a number representing the direction.
-        int dir_int = aocio::parse_hex(clr_str.substr(5, 1)).value();
-        assert(dir_int <= 3); 
-        if (dir_int == 0) {
-            dir = "R"; 
-        } else if (dir_int == 1) {
-            dir = "D"; 
-        } else if (dir_int == 2) {
-            dir = "L";
-        } else {
-            dir = "U";
-        }
-    }
+// Part 2: The first five hex digits of the colour represent the steps, the last digit the direction. 
+DigStep decode_colour(uint32_t colour)
+{
+    constexpr std::array<char, 4> dirs {'R', 'D', 'L', 'U'}; 
+    assert((colour & 0xf) <= 3); 
+    return DigStep {.dir = dirs.at(colour & 0xf), .steps = colour >> 4, .colour = {}}; 
+}
 
-    if (dir == "R") {
-        edge.second = prev_end_vert + Vec2{steps, 0}; 
-    } else if (dir == "L") {
-        edge.second = prev_end_vert - Vec2{steps, 0}; 
+Edge dig(const DigStep& step, Vec2& prev_end_vert)
+{
+    Edge edge; 
+    if (step.dir == 'R') {
+        edge.second = prev_end_vert + Vec2{step.steps, 0}; 
+    } else if (step.dir == 'L') {
+        edge.second = prev_end_vert - Vec2{step.steps, 0}; 
     } 
-    else if (dir == "U") {
-        edge.second = prev_end_vert - Vec2{0, steps}; 
-    } else if (dir == "D") {
-        edge.second = prev_end_vert + Vec2{0, steps}; 
+    else if (step.dir == 'U') {
+        edge.second = prev_end_vert - Vec2{0, step.steps}; 
+    } else if (step.dir == 'D') {
+        edge.second = prev_end_vert + Vec2{0, step.steps}; 
     } else {
         assert(false);
     }
 
     edge.first = prev_end_vert; 
     prev_end_vert = edge.second; 
-    boundary_points += steps;
     return edge;
 }
 
-int64_t part_one(const std::vector<std::string>& lines, bool part_2 = false)
+Edge parse_edge(std::string_view line, Vec2& prev_end_vert, bool part_2 = false)
 {
-    Vec2 prev_end_vert = {0, 0}; 
+    DigStep step = parse_dig_step(line); 
+    if (part_2) {
+        step = decode_colour(aocio::parse_hex6(step.colour).value()); 
+    }
+    return dig(step, prev_end_vert); 
+}
 
+struct Lagoon {
     int64_t area = 0; 
     int64_t boundary_points = 0; 
-    for (const auto& line : lines) {
+
+    void add_edge(const Edge& edge) 
+    {
+        area += (edge.first.y + edge.second.y) * (edge.first.x - edge.second.x); // Trapezoid formula. 
+        boundary_points += std::abs(edge.second.x - edge.first.x) + std::abs(edge.second.y - edge.first.y); 
+    }
+
+    int64_t volume() const 
+    {
+        int64_t abs_area = std::abs(area) / 2; // Trapezoid formula.  
+        int64_t inside_points = abs_area - boundary_points / 2 + 1; // Re-arranged Pick's theorem: A = i + b/2 - 1
+        return inside_points + boundary_points;
+    }
+};
+
+template <typename Lines> // Lines: the lines of a MappedInput, or a LineReader.
+int64_t part_one(Lines&& lines, bool part_2 = false)
+{
+    Vec2 prev_end_vert = {0, 0}; 
+    Lagoon lagoon; 
+    for (std::string_view line : lines) {
         if (!line.size()) {
             continue;
         }
-        std::string clr_str; 
-        std::pair<Vec2, Vec2> edge = parse_edge(line, prev_end_vert, boundary_points, part_2); 
-        area += (edge.first.y + edge.second.y) * (edge.first.x - edge.second.x); // Trapezoid formula. 
+        lagoon.add_edge(parse_edge(line, prev_end_vert, part_2)); 
     }
-    area = std::abs(area) / 2; // Trapezoid formula.  
-
-    int64_t inside_points = area - boundary_points / 2 + 1; // Re-arranged Pick's theorem: A = i + b/2 - 1
-    return inside_points + boundary_points;
+    return lagoon.volume(); 
 }
 
-int64_t part_two(const std::vector<std::string>& lines)
+template <typename Lines>
+int64_t part_two(Lines&& lines)
 {
     return part_one(lines, true);
 }
 
-int main()
+int64_t lagoon_volume(std::span<const Edge> edges)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    Lagoon lagoon; 
+    for (const Edge& edge : edges) {
+        lagoon.add_edge(edge); 
+    }
+    return lagoon.volume(); 
+}
+
+// The edges of part one and part two. 
+std::array<std::vector<Edge>, 2> parse_edges(std::span<const std::string_view> lines)
+{
+    std::vector<DigStep> steps; 
+    std::vector<std::string_view> colours; 
+    for (std::string_view line : lines) {
+        if (line.size()) {
+            steps.push_back(parse_dig_step(line)); 
+            colours.push_back(steps.back().colour); 
+        }
+    }
+    // Decode all colours of the plan at once. 
+    std::vector<uint32_t> decoded(colours.size()); 
+    if (!aocio::parse_hex6_batch(colours, decoded.data())) {
+        throw std::invalid_argument("parse_edges: Invalid colour"); 
+    }
+
+    std::array<std::vector<Edge>, 2> edges; 
+    for (int part = 0; part < 2; ++part) {
+        Vec2 prev_end_vert = {0, 0}; 
+        edges[part].reserve(steps.size()); 
+        for (std::size_t i = 0; i < steps.size(); ++i) {
+            edges[part].push_back(dig(part == 0 ? steps[i] : decode_colour(decoded[i]), prev_end_vert)); 
+        }
+    }
+    return edges; 
+}
+
+// Change it whenever Edge or the parsing change (cf. aoclib/input-cache.hpp). 
+constexpr std::string_view edges_cache_schema = "day-18 edges v1"; 
+
+// The edges of both parts, used directly from the input cache of a previous run if the input did not change (cf. aoclib/input-cache.hpp). 
+class EdgeLists 
+{
+    aocio::InputCache cache; 
+    std::array<std::vector<Edge>, 2> parsed; // Only used if there was no valid cache. 
+
+public: 
+    std::span<const Edge> part_one, part_two; 
+
+    EdgeLists(const aocio::MappedInput& input, std::string_view fname) 
+    {
+        const std::string cache_path = aocio::cache_path(fname, "edges"); 
+        const uint64_t input_hash = aocio::hash_bytes(input.contents()); 
+        if (cache.open(cache_path, input_hash, edges_cache_schema)) {
+            const auto cached_one = cache.get<Edge>(0); 
+            const auto cached_two = cache.get<Edge>(1); 
+            if (cached_one && cached_two) {
+                part_one = *cached_one; 
+                part_two = *cached_two; 
+                return; 
+            }
+        }
+
+        parsed = parse_edges(input.lines()); 
+        aocio::CacheWriter writer; 
+        writer.add(parsed[0]); 
+        writer.add(parsed[1]); 
+        writer.write(cache_path, input_hash, edges_cache_schema); 
+        part_one = parsed[0]; 
+        part_two = parsed[1]; 
+    }
+};
+
+// Used by the multi-day runner (cf. aoc/days.hpp); the edges of both parts are parsed in one pass. 
+std::pair<std::string, std::string> solve(std::string_view input)
+{
+    const std::array<std::vector<Edge>, 2> edges = parse_edges(aocio::split_lines(input)); 
+    return {std::to_string(lagoon_volume(edges[0])), std::to_string(lagoon_volume(edges[1]))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_18
+{
+
+static int run_day(int argc, char* argv[])
+{
+    const bool streamed = aocio::has_arg(argc, argv, "--stream"); // Read the input line by line with bounded memory. 
+    aocio::MappedInput input;
+    aocio::LineReader reader; 
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return streamed ? reader.open(fname) : input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
     try {
-        int64_t p1 = part_one(lines);  
+        if (streamed) {
+            int64_t p1 = aocio::timed_phase("part1", [&] { return part_one(reader); });
+            std::cout << "Part 1: " << p1 << "\n";
+            reader.rewind(); 
+            int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(reader); });
+            std::cout << "Part 2: " << p2 << "\n";
+            return EXIT_SUCCESS; 
+        }
+        const EdgeLists edges = aocio::timed_phase("parse", [&] { return EdgeLists {input, fname}; }); 
+        int64_t p1 = aocio::timed_phase("part1", [&] { return lagoon_volume(edges.part_one); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return lagoon_volume(edges.part_two); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const std::exception& err) {
         std::cerr << "Error: " << err.what() << "\n";
@@ -118,4 +241,13 @@ int main()
     }
     
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, [argc, argv]() { return day_18::run_day(argc, argv); });
+}
+#endif
\ No newline at end of file
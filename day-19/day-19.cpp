@@ -23,6 +23,9 @@
             - Takes about 10 ms to solve both parts on my laptop. 
 */
 
+namespace day_19
+{
+
 enum class Operator {LessThan, GreaterThan}; 
 enum class OperandType {x, m, a, s}; 
 
@@ -124,8 +127,9 @@ void parse_workflow(const std::string& line, std::unordered_map<std::string, Wor
     if (line.size() == 0) {
         return;
     }
-    std::vector<std::string> toks; 
-    aocio::line_tokenise(line, "{}<>,:", "{}<>,:", toks);
+    constexpr aocio::Delims workflow_delims {"{}<>,:", "{}<>,:"}; 
+    std::vector<std::string_view> toks; 
+    aocio::line_tokenise(line, workflow_delims, toks);
 
     if (toks.size() < 4) {
         throw std::invalid_argument("parse_workflow: Invalid workflow (too short)"); 
@@ -191,7 +195,7 @@ void parse_workflow(const std::string& line, std::unordered_map<std::string, Wor
         throw std::invalid_argument("parse_workflow: Missing { or }");
     }
 
-    std::string workflow_name = toks.at(0); 
+    std::string workflow_name {toks.at(0)}; 
     Workflow workflow; 
 
     for (std::size_t i = 2; i < toks.size() - 1; i += rule_num_tokens) {
@@ -223,8 +227,10 @@ void parse_parts(const std::string& line, std::vector<Part>& parts)
     if (line.size() == 0) {
         return;
     }
-    std::vector<std::string> toks; 
-    aocio::line_tokenise(line, ",{}", "{}", toks);
+    constexpr aocio::Delims part_delims {",{}", "{}"}; 
+    constexpr aocio::Delims assignment_delims {"="}; 
+    std::vector<std::string_view> toks, assignment_toks; 
+    aocio::line_tokenise(line, part_delims, toks);
 
     if (toks.size() != 6) {
         std::cout << line << "\n";
@@ -237,8 +243,7 @@ void parse_parts(const std::string& line, std::vector<Part>& parts)
     Part part; 
     bool set_x = false, set_m = false, set_a = false, set_s = false; 
     for (std::size_t i = 1; i < toks.size() - 1; ++i) {
-        std::vector<std::string> assignment_toks; 
-        aocio::line_tokenise(toks.at(i), "=", "", assignment_toks); 
+        aocio::line_tokenise(toks.at(i), assignment_delims, assignment_toks); 
         if (assignment_toks.size() != 2) {
             throw std::invalid_argument("parse_parts: Invalid assignment"); 
         }
@@ -296,7 +301,7 @@ void parse_parts(const std::string& line, std::vector<Part>& parts)
     parts.push_back(part);
 }
 
-int64_t part_one(const std::vector<std::string>& lines)
+int64_t part_one(std::span<const std::string> lines)
 {
     std::unordered_map<std::string, Workflow> workflows; 
     std::vector<Part> parts; 
@@ -458,7 +463,7 @@ void follow_path(const std::unordered_map<std::string, Workflow>& workflows, con
     }
 }
 
-int64_t part_two(const std::vector<std::string>& lines)
+int64_t part_two(std::span<const std::string> lines)
 {
     std::unordered_map<std::string, Workflow> workflows; 
 
@@ -478,27 +483,40 @@ int64_t part_two(const std::vector<std::string>& lines)
     return accepted_combinations;
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::vector<std::string> file_lines = aocio::split_lines<std::string>(input); 
+    const std::span<const std::string> lines = aocio::trim_empty_lines(file_lines); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_19
+{
+
+static int run_day()
+{
+    std::vector<std::string> file_lines;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return aocio::file_getlines(fname, file_lines); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
 
-    aocio::remove_leading_empty_lines(lines);
+    const std::span<const std::string> lines = aocio::trim_empty_lines(file_lines);
     if (!lines.size()) {
         std::cerr << "Error: " << "Input is empty";
         return EXIT_FAILURE;
     }
 
     try {
-        int64_t p1 = part_one(lines);  
+        int64_t p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const std::exception& err) {
         std::cerr << "Error: " << err.what() << "\n";
@@ -506,4 +524,13 @@ int main()
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_19::run_day);
+}
+#endif
\ No newline at end of file
@@ -31,6 +31,9 @@
                       This also means those "sub-networks" must not interfere with each other I think, but I'm not sure. 
 */
 
+namespace day_20
+{
+
 enum class Pulse {Low, High}; 
 
 class Module;
@@ -39,7 +42,7 @@ class Network
 {
 public: 
     std::unordered_map<std::string, std::unique_ptr<Module>> modules; // A network owns its modules. 
-    Network(const std::vector<std::string>& lines);
+    Network(std::span<const std::string> lines);
     void insert_module(std::unique_ptr<Module> mod);
     int64_t push_button(int n = 1);
 
@@ -151,7 +154,7 @@ public:
 };
 
 
-Network::Network(const std::vector<std::string>& lines)
+Network::Network(std::span<const std::string> lines)
 {
     for (std::string line : lines) {
         aocio::str_remove_whitespace(line);
@@ -250,7 +253,7 @@ int64_t Network::push_button(int n)
     return low_pulses * high_pulses;
 }
 
-int64_t find_lowest_rx(const std::vector<std::string>& lines)
+int64_t find_lowest_rx(std::span<const std::string> lines)
 {
     Network net {lines};
     auto module_before_rx_kv = std::find_if(net.modules.cbegin(), net.modules.cend(), [](const auto& kv) -> bool {
@@ -344,39 +347,52 @@ int64_t find_lowest_rx(const std::vector<std::string>& lines)
     return min_button_presses;
 }
 
-int64_t part_one(const std::vector<std::string>& lines)
+int64_t part_one(std::span<const std::string> lines)
 {
     Network network {lines};
     return network.push_button(1000);
 }
 
-int64_t part_two(const std::vector<std::string>& lines)
+int64_t part_two(std::span<const std::string> lines)
 {
     Network network {lines};
     return find_lowest_rx(lines);
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::vector<std::string> file_lines = aocio::split_lines<std::string>(input); 
+    const std::span<const std::string> lines = aocio::trim_empty_lines(file_lines); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_20
+{
+
+static int run_day()
+{
+    std::vector<std::string> file_lines;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return aocio::file_getlines(fname, file_lines); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
 
-    aocio::remove_leading_empty_lines(lines);
+    const std::span<const std::string> lines = aocio::trim_empty_lines(file_lines);
     if (!lines.size()) {
         std::cerr << "Error: " << "Input is empty";
         return EXIT_FAILURE;
     }
 
     try {
-        int64_t p1 = part_one(lines);  
+        int64_t p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const std::exception& err) {
         std::cerr << "Error: " << err.what() << "\n";
@@ -384,4 +400,13 @@ int main()
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_20::run_day);
+}
+#endif
\ No newline at end of file
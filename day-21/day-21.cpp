@@ -1,9 +1,8 @@
-#include <unordered_set>
-#include <queue>
-#include <numeric>
-
 #include "../aoclib/aocio.hpp"
 #include "../aoclib/grid.hpp"
+#include "../aoclib/bit-grid.hpp"
+#include "../aoclib/grid-view.hpp"
+#include "../aoclib/grid-bfs.hpp"
 #include "../aoclib/vec.hpp"
 
 /*
@@ -11,167 +10,144 @@
   
     Solutions: 
         - Part 1: 3770
-        - Part 2: TODO...
+        - Part 2: (my answer wasn't recorded; the example input gives -1, cf. part_two)
     Notes:  
         - Part 1: 
-        - Part 2:
+        - Part 2: Extrapolated from three BFS runs over the repeated map (cf. part_two); only works for maps like the real input, 
+                  the example map does not have the required properties, so part_two returns -1 for it.
 */
 
+namespace day_21
+{
+
 using aocutil::Grid; 
+using aocutil::BitGrid; 
 using Vec2 = aocutil::Vec2<int>;
 
-int64_t num_reachable(const Grid<char>& grid, int steps)
+Vec2 find_start(const aocutil::SymbolIndex<char>& symbols)
 {
-    Vec2 start_pos = grid.find_elem_positions('S').at(0);
-    std::unordered_set<Vec2> positions {start_pos};
-
-    for (int i = 0; i < steps; ++i) {
-        std::unordered_set<Vec2> reached; 
-        for (const Vec2& pos : positions) {
-            for (const Vec2& dir : aocutil::all_dirs_vec2<int>()) { // Try all neighbors. 
-                Vec2 adj_pos = pos + dir;
-                auto sym = grid.try_get(adj_pos); 
-                if (sym == '.' || sym == 'S') {
-                    reached.insert(adj_pos);
-                }
-            }
-        }
-        positions = reached; 
+    const std::span<const Vec2> starts = symbols.positions('S'); 
+    if (starts.size() != 1) {
+        throw std::invalid_argument("find_start: Not exactly one start position"); 
     }
-
-    return positions.size();
+    return starts.front(); 
 }
 
-int64_t part_one(const std::vector<std::string>& lines)
+int64_t num_reachable(const aocutil::GridView<const char>& grid, int steps)
 {
-    Grid<char> grid{lines}; 
-    return num_reachable(grid, 64); 
-}
+    const BitGrid garden = BitGrid::from_grid(grid, [](char sym) {return sym == '.' || sym == 'S';}); 
+    BitGrid positions {grid.width(), grid.height()}; 
+    positions.set(find_start(grid.index_symbols({'S'}))); 
 
-struct TileInfo {
-    bool visited = false; 
-    int distance = 0; 
-
-    friend std::ostream& operator<<(std::ostream& os, const TileInfo& t)
-    {
-        if (t.visited) {
-            return os << std::setw(3) << t.distance; 
-        } else {
-            return os << std::setw(3) << "#";
-        }
+    for (int i = 0; i < steps; ++i) { // One step for all positions at once (64 tiles per word). 
+        positions = positions.adjacent() & garden; 
     }
-};
 
- Grid<TileInfo> calc_distances(const Grid<char>& grid)
+    return positions.popcount();
+}
+
+// Runs directly on the input (cf. aocutil::text_grid_view), as it only reads the map. 
+int64_t part_one(std::string_view input)
+{
+    return num_reachable(aocutil::text_grid_view(input), 64); 
+}
+
+/*
+    BFS from start_pos ('S') over the infinitely repeated map (cf. aocutil::WrappingGridView), up to max_steps steps. 
+    The BFS area covers all positions within max_steps steps of 'S' (which is at its centre). 
+    Returns the number of plots at every distance (layer) from 'S'. 
+*/
+std::vector<int64_t> calc_layer_sizes(const Grid<char>& grid, const Vec2& start_pos, int max_steps)
 {
-    Vec2 start_pos = grid.find_elem_positions('S').at(0);
+    const aocutil::WrappingGridView<char> garden {grid}; 
+    const int size = 2 * max_steps + 1; 
+    const aocutil::Vec2<int64_t> origin {.x = start_pos.x - max_steps, .y = start_pos.y - max_steps}; // Of the BFS area on the map. 
+
+    std::vector<int64_t> layer_sizes; 
+    aocutil::grid_bfs(size, size, Vec2 {.x = max_steps, .y = max_steps}, [&garden, &origin](const Vec2& pos) {
+        return garden[{.x = origin.x + pos.x, .y = origin.y + pos.y}] != '#'; 
+    }, max_steps, [&layer_sizes](int32_t, std::span<const int32_t> layer) {
+        layer_sizes.push_back(std::ssize(layer)); 
+    }); 
+    return layer_sizes; 
+}
 
-    Grid<TileInfo> grid_data; 
-    for (int y = 0; y < grid.height(); ++y) {
-        grid_data.push_row(std::vector<TileInfo>(grid.width(), TileInfo{})); 
+// The plots reachable in exactly steps steps (you can always step back and forth, so all plots reachable in fewer steps of the same parity). 
+int64_t count_reachable(std::span<const int64_t> layer_sizes, int steps)
+{
+    int64_t cnt = 0; 
+    for (int dist = steps % 2; dist <= steps && dist < std::ssize(layer_sizes); dist += 2) {
+        cnt += layer_sizes[dist]; 
     }
+    return cnt; 
+}
 
-    std::queue<Vec2> q; 
-    q.push(start_pos); 
-
-    while (!q.empty()) {
-        Vec2 v = q.front(); 
-        q.pop();
-
-        if (grid_data.at(v).visited) {
-            continue;
-        } else {
-            grid_data.at(v).visited = true; 
-        }
-
-        int current_dist = grid_data.at(v).distance; 
-
-        for (const Vec2& dir : aocutil::all_dirs_vec2<int>()) { 
-            Vec2 adj_pos = v + dir; 
-            auto sym = grid.try_get(adj_pos); 
-            if (sym == '.' && !grid_data.at(adj_pos).visited) {
-                grid_data.at(adj_pos).distance = current_dist + 1; 
-                q.push(adj_pos); 
-            }
-        }
+/*
+    The (real) map is square, 'S' is at its centre, and the row and column of 'S' are free of rocks. 
+    Taking n (the size of the map) more steps then reaches one more ring of repeated maps, 
+    so for steps = n / 2 + k * n, the number of reachable plots is a quadratic function of k. 
+    We evaluate it for k = 0, 1, 2 with a BFS over the repeated map and extrapolate. 
+    (The example map does not have these properties; for maps like it, we return -1.)
+*/
+int64_t part_two(std::string_view input, int64_t steps = 26501365)
+{
+    const Grid<char> grid = aocutil::text_grid_view(input).to_grid(); 
+    const int n = grid.width(); 
+    const aocutil::SymbolIndex<char> symbols = grid.index_symbols({'S', '#'}); 
+    const Vec2 start_pos = find_start(symbols); 
+
+    const bool straight_paths = std::ranges::none_of(symbols.positions('#'), [&start_pos](const Vec2& rock) {
+        return rock.x == start_pos.x || rock.y == start_pos.y; 
+    }); 
+    if (grid.height() != n || start_pos.x != n / 2 || start_pos.y != n / 2 || steps % n != n / 2 || !straight_paths) {
+        return -1; 
     }
 
-    return grid_data; 
+    const int rem = steps % n; 
+    const std::vector<int64_t> layer_sizes = calc_layer_sizes(grid, start_pos, rem + 2 * n); 
+    const int64_t f0 = count_reachable(layer_sizes, rem); 
+    const int64_t f1 = count_reachable(layer_sizes, rem + n); 
+    const int64_t f2 = count_reachable(layer_sizes, rem + 2 * n); 
+
+    // f(k) = a * k^2 + b * k + c
+    const int64_t c = f0; 
+    const int64_t a = (f2 - 2 * f1 + f0) / 2; 
+    const int64_t b = f1 - f0 - a; 
+    const int64_t k = steps / n; 
+    return a * k * k + b * k + c; 
 }
 
-int64_t part_two(const std::vector<std::string>& lines)
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    Grid<char> grid{lines}; 
-    Grid<TileInfo> grid_data = calc_distances(grid); 
-
-    int steps = 64; 
-
-    int reachable = std::accumulate(grid_data.cbegin(), grid_data.cend(), 0, [steps](int total_reachable, const TileInfo& t) -> int {
-        if (!t.visited || t.distance > steps) {
-            return total_reachable; 
-        } else if (t.distance == steps) {
-            return total_reachable + 1; 
-        } else if ((steps % 2) == (t.distance % 2)) {
-            return total_reachable + 1;
-        } else {
-            return total_reachable;
-        }
-    });
-
-    // std::cout << grid_data << "\n";
-
-    auto and_op = [](bool a, bool b) -> bool {
-        return a && b; 
-    };
-    auto same_mod2 = [](const TileInfo& a, const TileInfo& b) -> bool {
-        return (a.distance % 2) == (b.distance % 2);
-    };
-    bool first_last_row_same_mod2 = std::inner_product(grid_data.cbegin_row(0), grid_data.cend_row(0), grid_data.cbegin_row(grid_data.height() - 1), true, and_op, same_mod2); 
-    bool first_last_col_same_mod2 = std::inner_product(grid_data.cbegin_col(0), grid_data.cend_col(0), grid_data.cbegin_col(grid_data.width() - 1), true, and_op, same_mod2); 
-    std::cout << "Row top and bottom same evenness: " << first_last_row_same_mod2 << "\n";
-    std::cout << "Col left and right same evenness: " << first_last_col_same_mod2 << "\n";
-
-    std::cout << "reachable: " << reachable << "\n";
-
-    Vec2 start_pos = grid.find_elem_positions('S').at(0); 
-    auto it_vert = std::find_if(grid.cbegin_col(start_pos.x), grid.cend_col(start_pos.x), [](char sym) {return sym == '#';});
-    if (it_vert != grid.cend_col(start_pos.x)) {
-        std::cout << "Grid: No straight vertical path to edge...\n";
-    } else {
-        std::cout << "Grid: Straight vertical path to edge!\n";
-    }
+    return {std::to_string(part_one(input)), std::to_string(part_two(input))}; 
+}
 
-    auto it_horiz = std::find_if(grid.cbegin_row(start_pos.y), grid.cend_row(start_pos.y), [](char sym) {return sym == '#';});
-    if (it_horiz != grid.cend_row(start_pos.y)) {
-        std::cout << "Grid: No straight horizontal path to edge...\n";
-    } else {
-        std::cout << "Grid: Straight horizontal path to edge!\n";
-    }
-    return -1; 
 }
 
-int main()
+#ifndef AOC_DAY_LIBRARY
+namespace day_21
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+
+static int run_day()
+{
+    aocio::MappedInput input;
     std::string_view fname = AOC_INPUT_PATH;
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return input.open(fname); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
 
-    aocio::remove_leading_empty_lines(lines);
-    aocio::remove_trailing_empty_lines(lines);
-    if (!lines.size()) {
+    if (aocio::trim_empty_lines(input.lines()).empty()) {
         std::cerr << "Error: " << "Input is empty";
         return EXIT_FAILURE;
     }
 
     try {
-        int64_t p1 = part_one(lines);  
+        int64_t p1 = aocio::timed_phase("part1", [&] { return part_one(input.contents()); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(input.contents()); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const std::exception& err) {
         std::cerr << "Error: " << err.what() << "\n";
@@ -179,4 +155,13 @@ int main()
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_21::run_day);
+}
+#endif
\ No newline at end of file
@@ -12,38 +12,53 @@
         - Part 2:
 */
 
-int64_t part_one(const std::vector<std::string>& lines)
+namespace day_xy // Rename to day_NN (and add the day to AOC_DAYS in aoc/days.hpp). 
+{
+
+int64_t part_one(std::span<const std::string> lines)
 {
     return -1;
 }
 
-int64_t part_two(const std::vector<std::string>& lines)
+int64_t part_two(std::span<const std::string> lines)
 {
     return -1; 
 }
 
-int main()
+// Used by the multi-day runner (cf. aoc/days.hpp). 
+std::pair<std::string, std::string> solve(std::string_view input)
 {
-    aocio::print_day();
-    std::vector<std::string> lines;
+    const std::vector<std::string> file_lines = aocio::split_lines<std::string>(input); 
+    const std::span<const std::string> lines = aocio::trim_empty_lines(file_lines); 
+    return {std::to_string(part_one(lines)), std::to_string(part_two(lines))}; 
+}
+
+}
+
+#ifndef AOC_DAY_LIBRARY
+namespace day_xy
+{
+
+static int run_day()
+{
+    std::vector<std::string> file_lines;
     std::string_view fname = AOC_INPUT_DIR"input-example.txt";
-    bool file_loaded = aocio::file_getlines(fname, lines);
+    bool file_loaded = aocio::timed_phase("load", [&] { return aocio::file_getlines(fname, file_lines); });
     if (!file_loaded) {
         std::cerr << "Error: " << "File '" << fname << "' not found\n";
         return EXIT_FAILURE;
     }    
 
-    aocio::remove_leading_empty_lines(lines);
-    aocio::remove_trailing_empty_lines(lines);
+    const std::span<const std::string> lines = aocio::trim_empty_lines(file_lines);
     if (!lines.size()) {
         std::cerr << "Error: " << "Input is empty";
         return EXIT_FAILURE;
     }
 
     try {
-        int64_t p1 = part_one(lines);  
+        int64_t p1 = aocio::timed_phase("part1", [&] { return part_one(lines); });
         std::cout << "Part 1: " << p1 << "\n";
-        int64_t p2 = part_two(lines);
+        int64_t p2 = aocio::timed_phase("part2", [&] { return part_two(lines); });
         std::cout << "Part 2: " << p2 << "\n";
     } catch (const std::exception& err) {
         std::cerr << "Error: " << err.what() << "\n";
@@ -51,4 +66,13 @@ int main()
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    aocio::print_day();
+    return aocio::timed_runs(argc, argv, day_xy::run_day);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../aoclib/aocio.hpp"
+#include "check.hpp"
+
+/*
+    parse_hex6_batch (two fields per SSE2 iteration, the rest one by one) against the scalar parse_hex:
+    upper- and lower-case digits, batches of every size up to 9 (odd ones end in the scalar tail),
+    and a single invalid character or a field of the wrong length anywhere in the batch, which must make it return false.
+*/
+
+using aoctest::check;
+
+static constexpr std::string_view hex_chars = "0123456789abcdefABCDEF";
+
+static std::string random_field(std::mt19937& rng)
+{
+    std::string field(6, '0');
+    for (char& c : field) {
+        c = hex_chars[rng() % hex_chars.size()];
+    }
+    return field;
+}
+
+static std::vector<std::string_view> views(const std::vector<std::string>& fields)
+{
+    return std::vector<std::string_view>(fields.begin(), fields.end());
+}
+
+static void check_valid_batches()
+{
+    std::mt19937 rng {10};
+    bool all_equal = true;
+    for (int round = 0; round < 200; ++round) {
+        for (std::size_t size = 0; size <= 9; ++size) {
+            std::vector<std::string> fields;
+            for (std::size_t i = 0; i < size; ++i) {
+                fields.push_back(random_field(rng));
+            }
+            std::vector<uint32_t> decoded(size);
+            bool same = aocio::parse_hex6_batch(views(fields), decoded.data());
+            for (std::size_t i = 0; i < size; ++i) {
+                same = same && decoded[i] == aocio::parse_hex<uint32_t>(fields[i]);
+            }
+            all_equal = all_equal && same;
+        }
+    }
+    check(all_equal, "batches decode like parse_hex");
+
+    const std::vector<std::string> extremes {"000000", "ffffff", "FFFFFF", "aBcDeF", "70c710", "0A0a0F"};
+    std::vector<uint32_t> decoded(extremes.size());
+    check(aocio::parse_hex6_batch(views(extremes), decoded.data())
+          && decoded == std::vector<uint32_t> {0, 0xffffff, 0xffffff, 0xabcdef, 0x70c710, 0x0a0a0f}, "fixed values");
+}
+
+static void check_invalid_batches()
+{
+    std::mt19937 rng {10};
+    // Just outside the ranges of the digits and letters (and a byte >= 0x80, i.e. negative as a signed char).
+    const std::string_view invalid_chars {"/:@G`g \x80\0", 9};
+    bool all_rejected = true;
+    for (std::size_t size = 1; size <= 5; ++size) {
+        for (std::size_t bad_field = 0; bad_field < size; ++bad_field) {
+            for (std::size_t bad_pos = 0; bad_pos < 6; ++bad_pos) {
+                for (char bad : invalid_chars) {
+                    std::vector<std::string> fields;
+                    for (std::size_t i = 0; i < size; ++i) {
+                        fields.push_back(random_field(rng));
+                    }
+                    fields[bad_field][bad_pos] = bad;
+                    std::vector<uint32_t> decoded(size);
+                    all_rejected = all_rejected && !aocio::parse_hex6_batch(views(fields), decoded.data());
+                }
+            }
+            std::vector<std::string> fields(size, "abcdef");
+            fields[bad_field] = bad_field % 2 ? "abcde" : "abcdef0";
+            std::vector<uint32_t> decoded(size);
+            all_rejected = all_rejected && !aocio::parse_hex6_batch(views(fields), decoded.data());
+        }
+    }
+    check(all_rejected, "an invalid digit or a field of the wrong length anywhere in the batch returns false");
+}
+
+int main()
+{
+    check_valid_batches();
+    check_invalid_batches();
+    return aoctest::exit_code();
+}
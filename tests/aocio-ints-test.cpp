@@ -0,0 +1,68 @@
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../aoclib/aocio.hpp"
+#include "check.hpp"
+
+/*
+    parse_int (the value, num_read and the range of IntT), parse_num (std::stoi-like prefixes) and extract_all_ints
+    (which '-' is a sign, skipped text, overflow, clearing the output) on hand-picked strings.
+*/
+
+using aoctest::check;
+
+template <typename IntT>
+static bool parses_to(std::string_view str, IntT value, std::size_t num_read)
+{
+    const auto parsed = aocio::parse_int<IntT>(str);
+    return parsed && parsed->value == value && parsed->num_read == num_read;
+}
+
+template <typename IntT = int>
+static bool extracts(std::string_view line, const std::vector<IntT>& expected)
+{
+    std::vector<IntT> out {42}; // Must be cleared.
+    return aocio::extract_all_ints(line, out) && out == expected;
+}
+
+static void check_parse_int()
+{
+    check(parses_to<int>("123abc", 123, 3) && parses_to<int>("-7", -7, 2) && parses_to<int>("0", 0, 1), "value and num_read");
+    check(parses_to<int>("007 ", 7, 3), "leading zeros are consumed");
+    check(!aocio::parse_int<int>("") && !aocio::parse_int<int>(" 5") && !aocio::parse_int<int>("+5") && !aocio::parse_int<int>("-")
+          && !aocio::parse_int<int>("x1"), "no integer at the start");
+    check(parses_to<int>("2147483647", std::numeric_limits<int>::max(), 10)
+          && parses_to<int>("-2147483648", std::numeric_limits<int>::min(), 11), "limits of int");
+    check(!aocio::parse_int<int>("2147483648") && !aocio::parse_int<int>("-2147483649"), "overflow of int");
+    check(parses_to<int64_t>("2147483648", int64_t {2147483648}, 10)
+          && parses_to<int64_t>("-9223372036854775808", std::numeric_limits<int64_t>::min(), 20), "int64_t");
+    check(parses_to<uint8_t>("255", 255, 3) && !aocio::parse_int<uint8_t>("256") && !aocio::parse_int<unsigned>("-1"), "unsigned types");
+
+    check(aocio::parse_num(" \t+42") == 42 && aocio::parse_num("-3 ") == -3, "parse_num skips whitespace and '+'");
+    check(!aocio::parse_num("+") && !aocio::parse_num("abc") && !aocio::parse_num("") && !aocio::parse_num_i64("99999999999999999999"),
+          "parse_num of no integer or overflow");
+}
+
+static void check_extract_all_ints()
+{
+    check(extracts("seeds: 79 14 55 13", {79, 14, 55, 13}) && extracts("Time:      7  15   30", {7, 15, 30}), "labels are skipped");
+    check(extracts("0 3 6 -3 -15", {0, 3, 6, -3, -15}) && extracts("-5", {-5}) && extracts("x=-5, y=-10 (-1)", {-5, -10, -1}),
+          "'-' at the start or after a separator is a sign");
+    check(extracts("a-5", {5}) && extracts("3-5", {3, 5}) && extracts("2-4,6-8", {2, 4, 6, 8}), "'-' after a letter or digit is not a sign");
+    check(extracts("--5", {-5}) && extracts("- 5", {5}) && extracts("5-", {5}) && extracts("-", {}), "other '-'");
+    check(extracts("", {}) && extracts("no numbers", {}) && extracts("1a2b3", {1, 2, 3}), "everything else separates");
+    check(extracts<unsigned>("-5 7", {5, 7}), "no signs for unsigned types");
+
+    std::vector<int> out;
+    check(!aocio::extract_all_ints("1 99999999999", out) && extracts<int64_t>("1 99999999999", {1, 99999999999}), "overflow");
+}
+
+int main()
+{
+    check_parse_int();
+    check_extract_all_ints();
+    return aoctest::exit_code();
+}
@@ -0,0 +1,71 @@
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../aoclib/aocio.hpp"
+#include "../aoclib/grid.hpp"
+#include "check.hpp"
+
+/*
+    trim_empty_lines and trim_leading_empty_lines (spans into the lines, for std::string and std::string_view lines)
+    against the expected lines, remove_leading/trailing_empty_lines on vectors, and a Grid constructed from the trimmed rows.
+    Lines of only spaces and tabs count as blank.
+*/
+
+using aoctest::check;
+
+template <typename Line>
+static std::vector<std::string> to_strings(std::span<const Line> lines)
+{
+    return std::vector<std::string>(lines.begin(), lines.end());
+}
+
+template <typename Line>
+static bool trims_to(const std::vector<Line>& lines, const std::vector<std::string>& leading, const std::vector<std::string>& both)
+{
+    const std::span<const Line> trimmed = aocio::trim_empty_lines(lines);
+    const bool points_into_lines = trimmed.empty() || (trimmed.data() >= lines.data() && trimmed.data() + trimmed.size() <= lines.data() + lines.size());
+    return to_strings(aocio::trim_leading_empty_lines(lines)) == leading && to_strings(trimmed) == both && points_into_lines;
+}
+
+template <typename Line>
+static void check_trim(std::string_view kind)
+{
+    const std::string what = std::string {"trim_empty_lines of "} + std::string {kind};
+    check(trims_to<Line>({}, {}, {}) && trims_to<Line>({"", " ", "\t"}, {}, {}), what + ": nothing but blank lines");
+    check(trims_to<Line>({"ab", "cd"}, {"ab", "cd"}, {"ab", "cd"}), what + ": nothing to trim");
+    check(trims_to<Line>({"", " \t", "ab", "", "cd", "  ", ""}, {"ab", "", "cd", "  ", ""}, {"ab", "", "cd"}),
+          what + ": blank lines at both ends, but not in between");
+    check(trims_to<Line>({"", " x "}, {" x "}, {" x "}), what + ": lines with spaces around text are not blank");
+}
+
+static void check_remove()
+{
+    std::vector<std::string> lines {"", "  ", "ab", "", "cd", "\t", ""};
+    aocio::remove_leading_empty_lines(lines);
+    check(lines == std::vector<std::string> {"ab", "", "cd", "\t", ""}, "remove_leading_empty_lines");
+    aocio::remove_trailing_empty_lines(lines);
+    check(lines == std::vector<std::string> {"ab", "", "cd"}, "remove_trailing_empty_lines");
+
+    std::vector<std::string> blank {"", " "};
+    aocio::remove_leading_empty_lines(blank);
+    check(blank.empty(), "remove_leading_empty_lines of blank lines only");
+}
+
+static void check_grid_from_span()
+{
+    const std::string text = "\n\n#.\n.#\n\n";
+    const std::vector<std::string> lines = aocio::split_lines<std::string>(text);
+    const aocutil::Grid<char> grid {aocio::trim_empty_lines(lines)};
+    check(grid.width() == 2 && grid.height() == 2 && grid.get(0, 0) == '#' && grid.get(1, 0) == '.' && grid.get(1, 1) == '#',
+          "Grid from the span of trimmed rows");
+}
+
+int main()
+{
+    check_trim<std::string>("std::string lines");
+    check_trim<std::string_view>("std::string_view lines");
+    check_remove();
+    check_grid_from_span();
+    return aoctest::exit_code();
+}
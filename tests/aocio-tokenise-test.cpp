@@ -0,0 +1,81 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../aoclib/aocio.hpp"
+#include "check.hpp"
+
+/*
+    The string_view overload of line_tokenise (with a Delims table) against the std::string overload: hand-picked lines
+    (preserved delimiters, consecutive delimiters, delimiters at both ends, empty lines) and random lines of up to 40 characters,
+    with up to 8 delimiters (scanned with for_each_byte_match on lines of 16+ characters) and with more (table lookups only).
+*/
+
+using aoctest::check;
+
+static bool same_tokens(std::string_view line, const std::string& delims, const std::string& preserved)
+{
+    std::vector<std::string> expected;
+    aocio::line_tokenise(line, delims, preserved, expected);
+    std::vector<std::string_view> tokens {"stale"}; // Must be cleared.
+    aocio::line_tokenise(line, aocio::Delims {delims, preserved}, tokens);
+    return std::vector<std::string>(tokens.begin(), tokens.end()) == expected;
+}
+
+static void check_fixed_lines()
+{
+    check(same_tokens("", " ,", "") && same_tokens("", " ,", ","), "empty lines give no tokens");
+    check(same_tokens("a b  c", " ", "") && same_tokens("  a,,b , ", " ,", ""), "consecutive delimiters give no empty tokens");
+    check(same_tokens("px{a<2006:qkq,m>2090:A,rfg}", "{},:", "{}") && same_tokens("{}{}", "{}", "{}"), "preserved delimiters are tokens");
+    check(same_tokens("Game 1: 3 blue, 4 red; 1 red, 2 green, 6 blue; 2 green", " ,:;", ";")
+          && same_tokens(";;a;;", " ;", ";"), "preserved delimiters in long lines and next to each other");
+
+    std::vector<std::string_view> tokens;
+    aocio::line_tokenise("broadcaster -> a, b, c", aocio::Delims {" ,->"}, tokens);
+    check(tokens == std::vector<std::string_view> {"broadcaster", "a", "b", "c"}, "tokens of a day 20 line");
+
+    bool threw = false;
+    try {
+        static_cast<void>(aocio::Delims {" ", ","});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "a preserved delimiter which is not a delimiter throws (like the std::string overload)");
+}
+
+static void check_random_lines()
+{
+    std::mt19937 rng {2};
+    const std::string alphabet = "ab1 ,;:{}->=|\t";
+    const std::string many_delims = " ,;:{}->=|\t"; // More than ByteSet::max_size, so no SIMD scan.
+    bool few_equal = true, many_equal = true;
+    for (int round = 0; round < 3000; ++round) {
+        std::string line(rng() % 41, ' ');
+        for (char& c : line) {
+            c = alphabet[rng() % alphabet.size()];
+        }
+        // Up to 8 random delimiters, some of them preserved.
+        std::string delims, preserved;
+        for (int i = 0, n = 1 + static_cast<int>(rng() % 8); i < n; ++i) {
+            const char d = many_delims[rng() % many_delims.size()];
+            if (delims.find(d) == std::string::npos) {
+                delims += d;
+                if (rng() % 3 == 0) {
+                    preserved += d;
+                }
+            }
+        }
+        few_equal = few_equal && same_tokens(line, delims, preserved);
+        many_equal = many_equal && same_tokens(line, many_delims, preserved);
+    }
+    check(few_equal, "same tokens with up to 8 delimiters");
+    check(many_equal, "same tokens with more than 8 delimiters");
+}
+
+int main()
+{
+    check_fixed_lines();
+    check_random_lines();
+    return aoctest::exit_code();
+}
@@ -0,0 +1,143 @@
+#include <cstdint>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+#include "../aoclib/bit-grid.hpp"
+#include "../aoclib/grid.hpp"
+#include "check.hpp"
+
+/*
+    BitGrid against a reference Grid of 0/1 cells (uint8_t, as Grid<bool> doesn't work, cf. grid-soa.hpp) on random grids
+    whose rows end just before, at and after word boundaries (widths 63, 64, 65 and 130, i.e. one to three words per row,
+    like the 131 cells of day 21): shifts by amounts within and across words (and beyond the grid), adjacent(), and_not(),
+    &, | and popcount(); the padding bits of the last word of a row must stay zero.
+*/
+
+using aocutil::BitGrid;
+using aocutil::Grid;
+using aoctest::check;
+using Reference = Grid<uint8_t>;
+
+static Reference random_reference(std::mt19937& rng, int width, int height)
+{
+    std::vector<uint8_t> cells(static_cast<std::size_t>(width) * height);
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        cells[i] = rng() % 3 == 0 ? 1 : 0;
+    }
+    return Reference {width, height, std::move(cells)};
+}
+
+static BitGrid to_bits(const Reference& ref)
+{
+    BitGrid bits {ref.width(), ref.height()};
+    for (int y = 0; y < ref.height(); ++y) {
+        for (int x = 0; x < ref.width(); ++x) {
+            bits.set(x, y, ref.get(x, y) != 0);
+        }
+    }
+    return bits;
+}
+
+// The cells and popcount equal ref, and no padding bit is set.
+static bool same_cells(const BitGrid& bits, const Reference& ref)
+{
+    int64_t cnt = 0;
+    for (int y = 0; y < ref.height(); ++y) {
+        for (int x = 0; x < ref.width(); ++x) {
+            if (bits.test(x, y) != (ref.get(x, y) != 0)) {
+                return false;
+            }
+            cnt += ref.get(x, y);
+        }
+        const std::span<const uint64_t> words = bits.row_words(y);
+        const int used_bits = ref.width() - 64 * (static_cast<int>(words.size()) - 1);
+        if (used_bits < 64 && (words.back() >> used_bits) != 0) {
+            return false;
+        }
+    }
+    return bits.popcount() == cnt;
+}
+
+// ref moved by (dx, dy), cells moved off the grid dropped.
+static Reference shifted(const Reference& ref, int dx, int dy)
+{
+    Reference res {ref.width(), ref.height(), std::vector<uint8_t>(static_cast<std::size_t>(ref.width()) * ref.height())};
+    for (int y = 0; y < ref.height(); ++y) {
+        for (int x = 0; x < ref.width(); ++x) {
+            if (res.pos_on_grid(x + dx, y + dy)) {
+                res.set(x + dx, y + dy, ref.get(x, y));
+            }
+        }
+    }
+    return res;
+}
+
+static Reference adjacent(const Reference& ref)
+{
+    Reference res {ref.width(), ref.height(), std::vector<uint8_t>(static_cast<std::size_t>(ref.width()) * ref.height())};
+    for (int y = 0; y < ref.height(); ++y) {
+        for (int x = 0; x < ref.width(); ++x) {
+            for (const aocutil::Vec2<int>& d : aocutil::all_dirs_vec2<int>()) {
+                if (ref.pos_on_grid(x + d.x, y + d.y) && ref.get(x + d.x, y + d.y)) {
+                    res.set(x, y, 1);
+                }
+            }
+        }
+    }
+    return res;
+}
+
+static Reference combined(const Reference& a, const Reference& b, uint8_t (*op)(uint8_t, uint8_t))
+{
+    Reference res = a;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            res.set(x, y, op(a.get(x, y), b.get(x, y)));
+        }
+    }
+    return res;
+}
+
+int main()
+{
+    std::mt19937 rng {12};
+    constexpr int height = 5;
+    bool from_ref_ok = true, horizontal_ok = true, vertical_ok = true, adjacent_ok = true, ops_ok = true;
+    for (int width : {63, 64, 65, 130}) {
+        for (int round = 0; round < 10; ++round) {
+            const Reference ref = random_reference(rng, width, height);
+            const BitGrid bits = to_bits(ref);
+            from_ref_ok = from_ref_ok && same_cells(bits, ref)
+                && BitGrid::from_grid(ref, [](uint8_t b) {return b != 0;}) == bits;
+
+            for (int n : {0, 1, 2, 31, 62, 63, 64, 65, 66, 127, 128, 129, width - 1, width, width + 1}) {
+                BitGrid left = bits, right = bits;
+                left.shift_left(n);
+                right.shift_right(n);
+                horizontal_ok = horizontal_ok && same_cells(left, shifted(ref, -n, 0)) && same_cells(right, shifted(ref, n, 0));
+            }
+            for (int n : {0, 1, 2, height - 1, height, height + 1}) {
+                BitGrid up = bits, down = bits;
+                up.shift_up(n);
+                down.shift_down(n);
+                vertical_ok = vertical_ok && same_cells(up, shifted(ref, 0, -n)) && same_cells(down, shifted(ref, 0, n));
+            }
+            adjacent_ok = adjacent_ok && same_cells(bits.adjacent(), adjacent(ref));
+
+            const Reference other_ref = random_reference(rng, width, height);
+            const BitGrid other = to_bits(other_ref);
+            BitGrid and_not = bits;
+            and_not.and_not(other);
+            ops_ok = ops_ok && same_cells(and_not, combined(ref, other_ref, [](uint8_t a, uint8_t b) -> uint8_t {return a & !b;}))
+                && same_cells(bits & other, combined(ref, other_ref, [](uint8_t a, uint8_t b) -> uint8_t {return a & b;}))
+                && same_cells(bits | other, combined(ref, other_ref, [](uint8_t a, uint8_t b) -> uint8_t {return a | b;}));
+        }
+    }
+    check(from_ref_ok, "set(), test(), from_grid() and popcount() agree with the reference");
+    check(horizontal_ok, "shift_left/shift_right carry cells across words and clear the padding");
+    check(vertical_ok, "shift_up/shift_down move whole rows");
+    check(adjacent_ok, "adjacent() equals the Von4 neighbourhood of the reference");
+    check(ops_ok, "and_not(), & and | equal the reference");
+    return aoctest::exit_code();
+}
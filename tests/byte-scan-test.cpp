@@ -0,0 +1,86 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../aoclib/byte-scan.hpp"
+#include "check.hpp"
+
+/*
+    for_each_byte_match/find_bytes against a scalar loop, on random buffers of all lengths up to a few blocks
+    (so every length modulo 16 and 32, i.e. every block tail) at unaligned starts, for sets of 1 to 8 bytes
+    (including '\0' and bytes >= 0x80). Only the kernel the compiler targets is tested by one build of this program,
+    so CMakeLists.txt builds it once per kernel (byte-scan-test, byte-scan-test-fallback and, if the host runs it, byte-scan-test-avx2).
+*/
+
+using aocio::ByteSet;
+using aoctest::check;
+
+#if defined(AOC_BYTE_SCAN_AVX2)
+constexpr std::string_view kernel = "AVX2";
+#elif defined(AOC_BYTE_SCAN_SSE2)
+constexpr std::string_view kernel = "SSE2";
+#else
+constexpr std::string_view kernel = "fallback";
+#endif
+
+static std::vector<std::size_t> scalar_matches(std::string_view data, std::string_view set)
+{
+    std::vector<std::size_t> offsets;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        if (set.find(data[i]) != std::string_view::npos) {
+            offsets.push_back(i);
+        }
+    }
+    return offsets;
+}
+
+// Bytes of the set are frequent (so blocks have several matches), other bytes are uniform over all 256 values.
+static std::string random_buffer(std::mt19937& rng, std::size_t size, std::string_view set)
+{
+    std::string buffer(size, '\0');
+    for (char& c : buffer) {
+        c = rng() % 4 == 0 ? set[rng() % set.size()] : static_cast<char>(rng() % 256);
+    }
+    return buffer;
+}
+
+static void check_sets(const std::vector<std::string>& sets)
+{
+    std::mt19937 rng {4};
+    bool for_each_equal = true, find_equal = true;
+    for (const std::string& set_bytes : sets) {
+        const ByteSet set {set_bytes};
+        for (std::size_t size = 0; size <= 200; ++size) {
+            const std::string buffer = random_buffer(rng, size + 3, set_bytes);
+            for (std::size_t start = 0; start < 3; ++start) { // Unaligned starts.
+                const std::string_view data = std::string_view {buffer}.substr(start, size);
+                const std::vector<std::size_t> expected = scalar_matches(data, set_bytes);
+
+                std::vector<std::size_t> visited;
+                aocio::for_each_byte_match(data, set, [&visited](std::size_t offset) { visited.push_back(offset); });
+                for_each_equal = for_each_equal && visited == expected;
+
+                std::vector<std::size_t> offsets(size);
+                offsets.resize(aocio::find_bytes(data, set, offsets.data()));
+                std::vector<std::size_t> appended {};
+                aocio::find_bytes(data, set, appended);
+                find_equal = find_equal && offsets == expected && appended == expected;
+            }
+        }
+    }
+    check(for_each_equal, "for_each_byte_match visits the offsets of the scalar loop, in order");
+    check(find_equal, "both find_bytes overloads give the offsets of the scalar loop");
+}
+
+int main()
+{
+    std::cout << "Kernel: " << kernel << "\n";
+    check_sets({"\n", std::string(1, '\0'), "\xff"});
+    check_sets({" ,", ":;|", "\n\r\t ,;:|", std::string {'\0', '\x80', '\xff', 'a', 'z', '0', '9', '\x7f'}});
+
+    bool none = true;
+    aocio::for_each_byte_match("abc", ByteSet {}, [&none](std::size_t) { none = false; });
+    check(none, "an empty set matches nothing");
+    return aoctest::exit_code();
+}
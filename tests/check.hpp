@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <source_location>
+#include <string_view>
+
+/*
+    The (framework-free) checks of the programs in tests/: check() reports a failed condition with its location
+    and every program returns aoctest::exit_code() from main, so ctest sees which program failed.
+*/
+
+namespace aoctest
+{
+
+inline int num_failed = 0;
+
+inline void check(bool cond, std::string_view what, std::source_location loc = std::source_location::current())
+{
+    if (!cond) {
+        std::cerr << loc.file_name() << ":" << loc.line() << ": Check failed: " << what << "\n";
+        ++num_failed;
+    }
+}
+
+inline int exit_code()
+{
+    if (num_failed) {
+        std::cerr << num_failed << " check(s) failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+}
@@ -0,0 +1,111 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "../day-03/day-03.cpp"
+#include "check.hpp"
+
+/*
+    Day 3 (which visits the neighbours of a cell with the Moore8 stencil) against a brute-force solution on the example
+    and on 50 random schematics, whose numbers and symbols also touch the edges.
+*/
+
+using aoctest::check;
+
+static const std::string example =
+    "467..114..\n"
+    "...*......\n"
+    "..35..633.\n"
+    "......#...\n"
+    "617*......\n"
+    ".....+.58.\n"
+    "..592.....\n"
+    "......755.\n"
+    "...$.*....\n"
+    ".664.598..\n";
+
+// Every number (a maximal run of digits) checks the cells of its surrounding rectangle.
+static std::pair<int64_t, int64_t> brute_force(const std::vector<std::string_view>& lines)
+{
+    const int height = static_cast<int>(lines.size());
+    std::vector<std::vector<std::vector<int>>> adjacent_nums(height); // The numbers next to each cell.
+    for (int row = 0; row < height; ++row) {
+        adjacent_nums[row].resize(lines[row].size());
+    }
+    int64_t part_sum = 0;
+    for (int row = 0; row < height; ++row) {
+        const int width = static_cast<int>(lines[row].size());
+        for (int begin = 0; begin < width; ++begin) {
+            if (!std::isdigit(lines[row][begin]) || (begin > 0 && std::isdigit(lines[row][begin - 1]))) {
+                continue;
+            }
+            int end = begin, num = 0;
+            for (; end < width && std::isdigit(lines[row][end]); ++end) {
+                num = num * 10 + (lines[row][end] - '0');
+            }
+            bool next_to_symbol = false;
+            for (int y = row - 1; y <= row + 1; ++y) {
+                for (int x = begin - 1; x <= end; ++x) {
+                    if (y < 0 || y >= height || x < 0 || x >= std::ssize(lines[y])) {
+                        continue;
+                    }
+                    const char c = lines[y][x];
+                    next_to_symbol = next_to_symbol || (c != '.' && !std::isdigit(c));
+                    adjacent_nums[y][x].push_back(num);
+                }
+            }
+            part_sum += next_to_symbol ? num : 0;
+        }
+    }
+    int64_t gear_ratio_sum = 0;
+    for (int row = 0; row < height; ++row) {
+        for (std::size_t col = 0; col < lines[row].size(); ++col) {
+            const std::vector<int>& nums = adjacent_nums[row][col];
+            if (lines[row][col] == '*' && nums.size() == 2) {
+                gear_ratio_sum += static_cast<int64_t>(nums[0]) * nums[1];
+            }
+        }
+    }
+    return {part_sum, gear_ratio_sum};
+}
+
+// Numbers of up to three digits (so the sums fit into an int), separated by '.' or symbols.
+static std::string random_schematic(std::mt19937& rng, int size)
+{
+    std::string text;
+    for (int y = 0; y < size; ++y) {
+        int run = 0;
+        for (int x = 0; x < size; ++x) {
+            const unsigned r = rng() % 100;
+            if (r >= 55 && r < 90 && run < 3) {
+                text += static_cast<char>('0' + rng() % 10);
+                ++run;
+            } else {
+                text += r < 90 ? '.' : "*#+$"[rng() % 4];
+                run = 0;
+            }
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+int main()
+{
+    const std::vector<std::string_view> example_lines = aocio::split_lines(example);
+    check(day_03::part_one(example_lines) == 4361 && day_03::part_two(example_lines) == 467835, "example");
+    check(brute_force(example_lines) == std::pair<int64_t, int64_t> {4361, 467835}, "brute force on the example");
+
+    std::mt19937 rng {25};
+    bool part_one_equal = true, part_two_equal = true;
+    for (int round = 0; round < 50; ++round) {
+        const std::string text = random_schematic(rng, 20 + 3 * round);
+        const std::vector<std::string_view> lines = aocio::split_lines(text);
+        const auto [part_sum, gear_ratio_sum] = brute_force(lines);
+        part_one_equal = part_one_equal && day_03::part_one(lines) == part_sum;
+        part_two_equal = part_two_equal && day_03::part_two(lines) == gear_ratio_sum;
+    }
+    check(part_one_equal, "part 1 equals the brute force on random schematics");
+    check(part_two_equal, "part 2 equals the brute force on random schematics");
+    return aoctest::exit_code();
+}
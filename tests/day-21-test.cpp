@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../day-21/day-21.cpp"
+#include "check.hpp"
+
+/*
+    Day 21 against a brute-force BFS over the repeated map: part 1 on the example, 
+    and the extrapolation of part 2 for steps = n / 2 + k * n on a random map with the properties of the real input.
+*/
+
+using aoctest::check;
+
+static const std::string example = 
+    "...........\n"
+    ".....###.#.\n"
+    ".###.##..#.\n"
+    "..#.#...#..\n"
+    "....#.#....\n"
+    ".##..S####.\n"
+    ".##..#...#.\n"
+    ".......##..\n"
+    ".##.#.####.\n"
+    ".##..##.##.\n"
+    "...........\n";
+
+// The plots reachable in exactly steps steps on the infinitely repeated map.
+static int64_t brute_force(const std::vector<std::string>& map, int64_t steps)
+{
+    const int64_t n = std::ssize(map);
+    std::unordered_map<aocutil::Vec2<int64_t>, int64_t> dist;
+    std::queue<aocutil::Vec2<int64_t>> queue;
+    const aocutil::Vec2<int64_t> start {.x = n / 2, .y = n / 2};
+    dist[start] = 0;
+    queue.push(start);
+    int64_t cnt = 0;
+    while (!queue.empty()) {
+        const aocutil::Vec2<int64_t> pos = queue.front();
+        queue.pop();
+        const int64_t d = dist[pos];
+        cnt += d % 2 == steps % 2;
+        if (d == steps) {
+            continue;
+        }
+        for (const aocutil::Vec2<int64_t>& dir : aocutil::all_dirs_vec2<int64_t>()) {
+            const aocutil::Vec2<int64_t> adj = pos + dir;
+            if (map[((adj.y % n) + n) % n][((adj.x % n) + n) % n] != '#' && !dist.contains(adj)) {
+                dist[adj] = d + 1;
+                queue.push(adj);
+            }
+        }
+    }
+    return cnt;
+}
+
+int main()
+{
+    check(day_21::num_reachable(aocutil::text_grid_view(example), 6) == 16, "example, 6 steps");
+    check(day_21::part_two(example, 5000) == -1, "example map is rejected by part_two");
+
+    // Rocks everywhere but on the row and column of 'S', the border, and a diamond around 'S' (like the real input).
+    const int n = 31;
+    std::mt19937 rng {21};
+    std::vector<std::string> map(n, std::string(n, '.'));
+    for (int y = 1; y < n - 1; ++y) {
+        for (int x = 1; x < n - 1; ++x) {
+            const int dist = std::abs(x - n / 2) + std::abs(y - n / 2);
+            if (x != n / 2 && y != n / 2 && std::abs(dist - n / 2) > 2 && rng() % 100 < 12) {
+                map[y][x] = '#';
+            }
+        }
+    }
+    map[n / 2][n / 2] = 'S';
+    std::string input;
+    for (const std::string& row : map) {
+        input += row + "\n";
+    }
+    for (int k : {2, 3, 4, 5}) {
+        const int64_t steps = n / 2 + k * n;
+        check(day_21::part_two(input, steps) == brute_force(map, steps), "part_two matches the brute force for k = " + std::to_string(k));
+    }
+    return aoctest::exit_code();
+}
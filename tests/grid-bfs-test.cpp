@@ -0,0 +1,127 @@
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../aoclib/grid-bfs.hpp"
+#include "check.hpp"
+
+/*
+    grid_bfs against a plain queue-based BFS on random maps: Von4 and Moore8, one or more (possibly equal) sources,
+    with and without max_dist; on_layer must be called once per distance, with all the reached cells.
+    Areas too large for the int32_t indices of the queue must throw.
+*/
+
+using aocutil::Grid;
+using aocutil::Vec2;
+using aoctest::check;
+
+// The distances of a textbook BFS over cells (row-major, '#' is a wall).
+static std::vector<int32_t> reference_bfs(int width, int height, const std::vector<char>& cells,
+                                          const std::vector<Vec2<int>>& sources, bool moore, int32_t max_dist)
+{
+    std::vector<int32_t> dist(cells.size(), aocutil::bfs_unreachable);
+    std::queue<int> queue;
+    for (const Vec2<int>& src : sources) {
+        const int idx = src.x + src.y * width;
+        if (dist[idx] < 0) {
+            dist[idx] = 0;
+            queue.push(idx);
+        }
+    }
+    while (!queue.empty()) {
+        const int idx = queue.front();
+        queue.pop();
+        if (dist[idx] == max_dist) {
+            continue;
+        }
+        const int x = idx % width, y = idx / width;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                const int adj_x = x + dx, adj_y = y + dy;
+                if ((dx == 0 && dy == 0) || (!moore && dx != 0 && dy != 0)
+                    || adj_x < 0 || adj_x >= width || adj_y < 0 || adj_y >= height) {
+                    continue;
+                }
+                const int adj = adj_x + adj_y * width;
+                if (dist[adj] < 0 && cells[adj] != '#') {
+                    dist[adj] = dist[idx] + 1;
+                    queue.push(adj);
+                }
+            }
+        }
+    }
+    return dist;
+}
+
+static void check_random_maps()
+{
+    std::mt19937 rng {20};
+    bool dists_equal = true, layers_in_order = true, layers_complete = true;
+    for (int round = 0; round < 300; ++round) {
+        const int width = 1 + static_cast<int>(rng() % 40), height = 1 + static_cast<int>(rng() % 40);
+        std::vector<char> cells(static_cast<std::size_t>(width) * height);
+        for (char& c : cells) {
+            c = rng() % 4 ? '.' : '#';
+        }
+        const Grid<char> grid {width, height, std::span<const char> {cells}};
+        std::vector<Vec2<int>> sources;
+        for (int i = 0, num_sources = 1 + static_cast<int>(rng() % 3); i < num_sources; ++i) {
+            sources.push_back({.x = static_cast<int>(rng() % width), .y = static_cast<int>(rng() % height)});
+        }
+        const int32_t max_dist = rng() % 2 ? 1000 : static_cast<int32_t>(rng() % 10);
+        const bool moore = rng() % 2;
+
+        int32_t num_layers = 0;
+        int64_t num_reached = 0;
+        auto passable = [&grid](const Vec2<int>& pos) {return grid[pos] != '#';};
+        auto on_layer = [&](int32_t dist, std::span<const int32_t> layer) {
+            layers_in_order = layers_in_order && dist == num_layers++;
+            num_reached += static_cast<int64_t>(layer.size());
+        };
+        const Grid<int32_t> dist = moore
+            ? aocutil::grid_bfs<aocutil::stencil::Moore8>(width, height, sources, passable, max_dist, on_layer)
+            : aocutil::grid_bfs(width, height, sources, passable, max_dist, on_layer);
+
+        const std::vector<int32_t> expected = reference_bfs(width, height, cells, sources, moore, max_dist);
+        int64_t expected_reached = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const int32_t d = expected[x + static_cast<std::size_t>(y) * width];
+                dists_equal = dists_equal && dist.get(x, y) == d;
+                expected_reached += d >= 0;
+            }
+        }
+        layers_complete = layers_complete && num_reached == expected_reached;
+    }
+    check(dists_equal, "distances equal the reference BFS");
+    check(layers_in_order, "on_layer is called for every distance in order");
+    check(layers_complete, "the layers contain every reached cell once");
+}
+
+static void check_single_source()
+{
+    const Grid<int32_t> dist = aocutil::grid_bfs(3, 1, Vec2<int> {.x = 0, .y = 0}, [](const Vec2<int>&) {return true;});
+    check(dist.get(0, 0) == 0 && dist.get(1, 0) == 1 && dist.get(2, 0) == 2, "distances along a row");
+}
+
+// Areas with more cells than int32_t indices can address throw (before allocating anything).
+static void check_too_large()
+{
+    bool threw = false;
+    try {
+        static_cast<void>(aocutil::grid_bfs(1 << 16, (1 << 15) + 1, Vec2<int> {.x = 0, .y = 0}, [](const Vec2<int>&) {return true;}));
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    check(threw, "more than INT32_MAX cells throw std::length_error");
+}
+
+int main()
+{
+    check_random_maps();
+    check_single_source();
+    check_too_large();
+    return aoctest::exit_code();
+}
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../aoclib/grid.hpp"
+#include "check.hpp"
+
+/*
+    Grids with a sentinel border: begin()/end() (like row(), at() etc.) only cover the cells of the grid, 
+    storage() covers the border, too; and the iterators behave like random access iterators across the skipped border. 
+*/
+
+using aocutil::Grid;
+using aocutil::Vec2;
+using aoctest::check;
+
+int main()
+{
+    const std::vector<std::string> rows {"ab#", "#cd", "e#f", "ghi"};
+    for (int border : {0, 1, 3}) {
+        Grid<char> grid {std::span<const std::string> {rows}, border, '#'};
+        const Grid<char>& const_grid = grid;
+        const std::string cells = "ab##cde#fghi";
+
+        check(std::ranges::count(grid, '#') == 3, "begin()/end() don't count the border");
+        check(std::ranges::count(grid.storage(), '#') == 3 + static_cast<long>(grid.storage().size() - cells.size()), "storage() includes the border");
+        check(std::equal(grid.cbegin(), grid.cend(), cells.begin(), cells.end()), "cells in row-major order");
+        check(std::equal(const_grid.begin(), const_grid.end(), cells.begin(), cells.end()), "const begin()/end()");
+        check(grid.cend() - grid.cbegin() == 12 && std::distance(grid.begin(), grid.end()) == 12, "distance is the number of cells");
+        check(std::equal(std::make_reverse_iterator(grid.cend()), std::make_reverse_iterator(grid.cbegin()), cells.rbegin(), cells.rend()), 
+              "backwards across the border");
+
+        bool random_access_ok = true;
+        for (int i = 0; i < 12; ++i) {
+            for (int j = 0; j < 12; ++j) {
+                const auto it = grid.cbegin() + i;
+                random_access_ok = random_access_ok && *it == cells[i] && it[j - i] == cells[j] && *(it + (j - i)) == cells[j] 
+                                   && (grid.cbegin() + j) - it == j - i && ((it < grid.cbegin() + j) == (i < j));
+            }
+        }
+        check(random_access_ok, "iterator arithmetic matches the cell indices");
+
+        std::sort(grid.begin(), grid.end());
+        std::string sorted = cells;
+        std::ranges::sort(sorted);
+        check(std::equal(grid.cbegin(), grid.cend(), sorted.begin(), sorted.end()), "sorting the cells");
+        bool border_intact = true;
+        for (int y = -border; y < grid.height() + border; ++y) {
+            for (int x = -border; x < grid.width() + border; ++x) {
+                border_intact = border_intact && (grid.pos_on_grid(x, y) || grid[{.x = x, .y = y}] == '#');
+            }
+        }
+        check(border_intact, "sorting the cells leaves the border alone");
+    }
+
+    const Grid<char> empty {std::span<const std::string> {}, 2, '#'};
+    check(empty.cbegin() == empty.cend(), "empty grid with a border");
+    return aoctest::exit_code();
+}
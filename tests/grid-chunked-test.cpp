@@ -0,0 +1,92 @@
+#include <array>
+#include <map>
+#include <random>
+#include <utility>
+#include "../aoclib/grid-chunked.hpp"
+#include "check.hpp"
+
+/*
+    ChunkedGrid against a std::map of the written cells: negative coordinates, cells on both sides of chunk boundaries,
+    and moved-from grids (which must be empty and independent of the grid they were moved into).
+*/
+
+using aocutil::ChunkedGrid;
+using aocutil::Vec2;
+using aoctest::check;
+
+static void check_random_writes()
+{
+    ChunkedGrid<int, 3> grid {-1}; // Small chunks, so there are many boundaries.
+    std::map<std::pair<int64_t, int64_t>, int> expected;
+    std::mt19937_64 rng {24};
+    std::uniform_int_distribution<int64_t> coord {-40, 40};
+    for (int i = 0; i < 5000; ++i) {
+        const Vec2<int64_t> pos {.x = coord(rng), .y = coord(rng)};
+        const int value = static_cast<int>(rng() % 1000);
+        grid.set(pos, value);
+        expected[{pos.x, pos.y}] = value;
+    }
+    bool all_equal = true;
+    for (int64_t y = -45; y <= 45; ++y) {
+        for (int64_t x = -45; x <= 45; ++x) {
+            const auto found = expected.find({x, y});
+            all_equal = all_equal && grid.get({.x = x, .y = y}) == (found == expected.end() ? -1 : found->second);
+        }
+    }
+    check(all_equal, "random writes read back (default for unwritten cells)");
+    check(grid.count_if([](int v) {return v >= 0;}) == static_cast<int64_t>(expected.size()), "count_if counts the written cells");
+}
+
+static void check_chunk_boundaries()
+{
+    ChunkedGrid<int> grid;
+    constexpr int64_t n = ChunkedGrid<int>::chunk_size;
+    // -1 and 0, n - 1 and n are in different chunks; so are huge coordinates of opposite signs.
+    const std::array<Vec2<int64_t>, 6> cells {{
+        {.x = -1, .y = -1}, {.x = 0, .y = 0}, {.x = n - 1, .y = 0}, {.x = n, .y = 0},
+        {.x = -(int64_t{1} << 40), .y = 7}, {.x = int64_t{1} << 40, .y = 7}
+    }};
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        grid.set(cells[i], static_cast<int>(i) + 1);
+    }
+    bool all_equal = true;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        all_equal = all_equal && grid.get(cells[i]) == static_cast<int>(i) + 1;
+    }
+    check(all_equal, "cells next to chunk boundaries keep their values");
+    check(grid.num_chunks() == 5, "one chunk per touched chunk");
+    check(grid.get({.x = -n, .y = 0}) == 0 && grid.get({.x = n + 1, .y = -1}) == 0, "neighbouring cells stay default");
+}
+
+static void check_moves()
+{
+    ChunkedGrid<int> a;
+    a.set({.x = 0, .y = 0}, 1);
+    ChunkedGrid<int> b {std::move(a)};
+    check(b.get({.x = 0, .y = 0}) == 1, "move construction keeps the cells");
+    check(a.num_chunks() == 0 && a.get({.x = 0, .y = 0}) == 0, "moved-from grid is empty");
+    a.set({.x = 0, .y = 0}, 99);
+    check(b.get({.x = 0, .y = 0}) == 1, "writes to a moved-from grid don't reach the destination");
+
+    ChunkedGrid<int> c;
+    c.set({.x = 5, .y = 5}, 3);
+    c = std::move(b);
+    check(c.get({.x = 0, .y = 0}) == 1 && c.get({.x = 5, .y = 5}) == 0, "move assignment replaces the cells");
+    check(b.num_chunks() == 0 && b.get({.x = 0, .y = 0}) == 0, "moved-from grid is empty after move assignment");
+    {
+        ChunkedGrid<int> d;
+        d.set({.x = 0, .y = 0}, 7);
+        b = std::move(d);
+    } // d is destroyed; b must not refer to anything of it.
+    check(b.get({.x = 0, .y = 0}) == 7, "grid moved out of a destroyed grid is intact");
+    b.set({.x = 0, .y = 0}, 8);
+    check(b.get({.x = 0, .y = 0}) == 8 && c.get({.x = 0, .y = 0}) == 1, "grids stay independent after moves");
+}
+
+int main()
+{
+    check_random_writes();
+    check_chunk_boundaries();
+    check_moves();
+    return aoctest::exit_code();
+}
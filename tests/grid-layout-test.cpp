@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../aoclib/grid.hpp"
+#include "check.hpp"
+
+/*
+    Grids of every storage layout against the row-major grid of the same elements (element access, iterators, columns, rows),
+    the storage indices of a layout being distinct, and the size of the Morton storage for very uneven shapes.
+*/
+
+using aocutil::Grid;
+using aoctest::check;
+
+template <typename Layout>
+static void check_layout(int width, int height)
+{
+    std::mt19937 rng {static_cast<unsigned>(width * 1000 + height)};
+    std::vector<std::vector<int>> rows(height, std::vector<int>(width));
+    std::vector<int> flat;
+    for (std::vector<int>& row : rows) {
+        for (int& elem : row) {
+            elem = static_cast<int>(rng() % 10);
+        }
+        flat.insert(flat.end(), row.begin(), row.end());
+    }
+    const Grid<int> expected {rows};
+    Grid<int, Layout> grid {rows};
+    const Grid<int, Layout> from_flat {width, height, flat};
+
+    bool all_equal = true;
+    std::vector<std::size_t> indices;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            all_equal = all_equal && grid.at(x, y) == expected.at(x, y) && from_flat.get(x, y) == expected.get(x, y) 
+                        && grid[{.x = x, .y = y}] == expected[{.x = x, .y = y}];
+            indices.push_back(grid.index(x, y));
+        }
+    }
+    check(all_equal, "elements match the row-major grid");
+    std::ranges::sort(indices);
+    check(std::adjacent_find(indices.begin(), indices.end()) == indices.end() && (indices.empty() || indices.back() < grid.storage().size()), 
+          "storage indices are distinct and within the storage");
+    check(std::equal(grid.cbegin(), grid.cend(), expected.cbegin(), expected.cend()), "iteration in row-major order");
+    for (int x = 0; x < width; ++x) {
+        all_equal = all_equal && std::equal(grid.cbegin_col(x), grid.cend_col(x), expected.cbegin_col(x), expected.cend_col(x));
+    }
+    for (int y = 0; y < height; ++y) {
+        all_equal = all_equal && std::equal(grid.cbegin_row(y), grid.cend_row(y), expected.cbegin_row(y), expected.cend_row(y));
+    }
+    check(all_equal, "column and row iterators");
+    check(grid.find_elem_positions(7) == expected.find_elem_positions(7), "find_elem_positions");
+    grid.set(width - 1, height - 1, 42);
+    check(grid.get(width - 1, height - 1) == 42 && *std::prev(grid.end()) == 42, "set the last element");
+}
+
+int main()
+{
+    for (const auto& [width, height] : {std::pair {1, 1}, {3, 5}, {33, 17}, {64, 64}, {70, 130}, {2, 300}, {300, 3}}) {
+        check_layout<aocutil::RowMajor>(width, height);
+        check_layout<aocutil::Tiled<8>>(width, height);
+        check_layout<aocutil::Tiled<>>(width, height);
+        check_layout<aocutil::Morton>(width, height);
+    }
+    // Blocks of the shorter side, so the storage stays within about four times the number of elements.
+    check(aocutil::Morton {2, 1000000}.size() == 2000000, "Morton size of 2 * 1000000");
+    check(aocutil::Morton {1000000, 3}.size() == 4000000, "Morton size of 1000000 * 3");
+    check(aocutil::Morton {1, 7}.size() == 7, "Morton size of 1 * 7");
+    check(aocutil::Morton {64, 64}.size() == 64 * 64, "Morton size of 64 * 64");
+    check(aocutil::Morton {0, 5}.size() == 0, "Morton size of an empty grid");
+    check(aocutil::Morton {64, 64}.index(5, 3) == (aocutil::Morton::spread_bits(5) | (aocutil::Morton::spread_bits(3) << 1)), 
+          "plain Z-order for power-of-two squares");
+    return aoctest::exit_code();
+}
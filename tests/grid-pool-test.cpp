@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../aoclib/grid-pool.hpp"
+#include "check.hpp"
+
+/*
+    EpochGrid against a plain vector over many resets, and ScratchGridPool: leased grids are reset to the requested default,
+    and repeated runs with grids of the same sizes don't allocate after the first run (counted by replacing operator new).
+*/
+
+using aocutil::EpochGrid;
+using aocutil::ScratchGridPool;
+using aocutil::Vec2;
+using aoctest::check;
+
+static long num_allocs = 0;
+
+void* operator new(std::size_t size)
+{
+    ++num_allocs;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc {};
+}
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+static void check_resets()
+{
+    constexpr int width = 13, height = 6;
+    EpochGrid<int> grid {width, height, -1};
+    std::vector<int> expected(width * height, -1);
+    std::mt19937 rng {23};
+    bool all_equal = true, touched_equal = true;
+    for (int run = 0; run < 100; ++run) {
+        const int default_value = run % 3 - 1;
+        grid.reset(default_value);
+        std::vector<bool> written(expected.size());
+        std::fill(expected.begin(), expected.end(), default_value);
+        for (int i = 0, num_writes = static_cast<int>(rng() % 40); i < num_writes; ++i) {
+            const Vec2<int> pos {.x = static_cast<int>(rng() % width), .y = static_cast<int>(rng() % height)};
+            grid.touch(pos) += 2;
+            expected[pos.x + pos.y * width] += 2;
+            written[pos.x + pos.y * width] = true;
+        }
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                all_equal = all_equal && grid.get({.x = x, .y = y}) == expected[x + y * width];
+                touched_equal = touched_equal && grid.touched({.x = x, .y = y}) == written[x + y * width];
+            }
+        }
+    }
+    check(all_equal, "cells read as the default value or the value written since the last reset");
+    check(touched_equal, "touched() tells the cells written since the last reset");
+}
+
+static void check_pool()
+{
+    ScratchGridPool<int> pool;
+    bool values_ok = true;
+    long first_run_allocs = 0, later_allocs = 0;
+    for (int run = 0; run < 5; ++run) {
+        const long before = num_allocs;
+        {
+            auto a = pool.acquire(10, 5, -1);
+            auto b = pool.acquire(10, 5, 7);
+            auto c = pool.acquire(3, 4);
+            values_ok = values_ok && a->get({.x = 3, .y = 3}) == -1 && b->get({.x = 3, .y = 3}) == 7 && c->get({.x = 2, .y = 3}) == 0;
+            values_ok = values_ok && !a->touched({.x = 3, .y = 3}) && !b->touched({.x = 1, .y = 1});
+            a->set({.x = 3, .y = 3}, run);
+            b->touch({.x = 1, .y = 1}) += 5;
+            c->set({.x = 2, .y = 3}, 1);
+            values_ok = values_ok && a->get({.x = 3, .y = 3}) == run && b->get({.x = 1, .y = 1}) == 12 && b->touched({.x = 1, .y = 1});
+        }
+        (run == 0 ? first_run_allocs : later_allocs) += num_allocs - before;
+    }
+    check(values_ok, "leased grids are reset to the requested default value");
+    check(first_run_allocs > 0, "the first run allocates its grids");
+    check(later_allocs == 0, "later runs reuse the returned grids without allocating");
+}
+
+int main()
+{
+    check_resets();
+    check_pool();
+    return aoctest::exit_code();
+}
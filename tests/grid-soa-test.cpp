@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "../aoclib/grid-soa.hpp"
+#include "check.hpp"
+
+/*
+    SoAGrid: initial values, writes through get<I>(), set_cell() and plane(i) against plain vectors of the fields,
+    independence of the planes, and the bounds checks of cell() and set_cell().
+*/
+
+using aocutil::SoAGrid;
+using aocutil::UniformSoAGrid;
+using aocutil::Vec2;
+using aoctest::check;
+
+static void check_mixed_fields()
+{
+    SoAGrid<char, int, double> grid {3, 2, 'a', 7, 1.5};
+    check(grid.width() == 3 && grid.height() == 2 && grid.num_fields == 3, "size and number of fields");
+    check(grid.cell({.x = 1, .y = 1}) == std::tuple<char, int, double> {'a', 7, 1.5}, "every cell starts as the initial values");
+
+    grid.get<1>({.x = 1, .y = 1}) = 9;
+    grid.set_cell({.x = 2, .y = 0}, 'z', 3, 2.5);
+    check(grid.plane<1>().get(1, 1) == 9 && grid.get<0>({.x = 1, .y = 1}) == 'a', "get<I>() writes one field only");
+    check(grid.cell({.x = 2, .y = 0}) == std::tuple<char, int, double> {'z', 3, 2.5}, "set_cell() writes every field");
+    check(grid.get<2>({.x = 0, .y = 0}) == 1.5, "other cells are unchanged");
+
+    bool cell_threw = false, set_cell_threw = false;
+    try {
+        static_cast<void>(grid.cell({.x = 3, .y = 0}));
+    } catch (const std::out_of_range&) {
+        cell_threw = true;
+    }
+    try {
+        grid.set_cell({.x = 0, .y = -1}, 'b', 0, 0.0);
+    } catch (const std::out_of_range&) {
+        set_cell_threw = true;
+    }
+    check(cell_threw && set_cell_threw, "cell() and set_cell() throw outside the grid");
+}
+
+static void check_uniform_planes()
+{
+    constexpr int width = 9, height = 7;
+    constexpr std::size_t num_planes = 5;
+    UniformSoAGrid<int, num_planes> grid {width, height, -1};
+    // The same writes to one plain vector per plane.
+    std::vector<std::vector<int>> expected(num_planes, std::vector<int>(width * height, -1));
+    std::mt19937 rng {22};
+    for (int i = 0; i < 2000; ++i) {
+        const std::size_t p = rng() % num_planes;
+        const Vec2<int> pos {.x = static_cast<int>(rng() % width), .y = static_cast<int>(rng() % height)};
+        const int value = static_cast<int>(rng() % 1000);
+        grid.plane(p)[pos] = value;
+        expected[p][pos.x + pos.y * width] = value;
+    }
+    bool all_equal = true;
+    for (std::size_t p = 0; p < num_planes; ++p) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                all_equal = all_equal && grid.plane(p).get(x, y) == expected[p][x + y * width];
+            }
+        }
+    }
+    check(all_equal, "writes through plane(i) only reach plane i");
+    check(grid.plane<3>().get(4, 2) == grid.plane(3).get(4, 2), "plane<I>() and plane(i) are the same plane");
+
+    const SoAGrid<int> single {2, 2, 5};
+    check(single.plane(0).get(1, 1) == 5, "a single field is uniform");
+}
+
+int main()
+{
+    check_mixed_fields();
+    check_uniform_planes();
+    return aoctest::exit_code();
+}
@@ -0,0 +1,64 @@
+#include <string>
+#include <vector>
+#include "../aoclib/grid-stencil.hpp"
+#include "../aoclib/grid-view.hpp"
+#include "check.hpp"
+
+/*
+    for_each_neighbor_pos against a naive bounds-checked loop over the offsets, for every position of small areas
+    (including positions just outside the area and areas smaller than the stencil), for Von4, Moore8 and a Custom stencil.
+*/
+
+using aocutil::Vec2;
+using aoctest::check;
+namespace stencil = aocutil::stencil;
+
+using Sparse = stencil::Custom<Vec2<int>{.x = 2, .y = 0}, Vec2<int>{.x = -3, .y = 1}, Vec2<int>{.x = 0, .y = -2}>;
+static_assert(stencil::radius<stencil::Von4> == 1 && stencil::radius<stencil::Moore8> == 1 && stencil::radius<Sparse> == 3);
+
+template <typename Stencil>
+static bool same_as_naive_loop(int width, int height)
+{
+    for (int y = -1; y <= height; ++y) {
+        for (int x = -1; x <= width; ++x) {
+            std::vector<Vec2<int>> visited, expected;
+            aocutil::for_each_neighbor_pos<Stencil>(width, height, {.x = x, .y = y}, [&visited](const Vec2<int>& adj) {
+                visited.push_back(adj);
+            });
+            for (const Vec2<int>& offset : Stencil::offsets) {
+                const Vec2<int> adj {.x = x + offset.x, .y = y + offset.y};
+                if (adj.x >= 0 && adj.x < width && adj.y >= 0 && adj.y < height) {
+                    expected.push_back(adj);
+                }
+            }
+            if (visited != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    bool von4_ok = true, moore8_ok = true, sparse_ok = true;
+    for (int width : {0, 1, 2, 3, 5, 8}) {
+        for (int height : {0, 1, 3, 7}) {
+            von4_ok = von4_ok && same_as_naive_loop<stencil::Von4>(width, height);
+            moore8_ok = moore8_ok && same_as_naive_loop<stencil::Moore8>(width, height);
+            sparse_ok = sparse_ok && same_as_naive_loop<Sparse>(width, height);
+        }
+    }
+    check(von4_ok, "Von4 visits the neighbours in the area, in the order of the offsets");
+    check(moore8_ok, "Moore8 visits the neighbours in the area, in the order of the offsets");
+    check(sparse_ok, "Custom stencil with radius 3 visits the neighbours in the area, in the order of the offsets");
+
+    const std::string text = "ab\ncd\n";
+    const auto view = aocutil::text_grid_view(text);
+    std::string neighbours;
+    aocutil::for_each_neighbor<stencil::Moore8>(view, {.x = 0, .y = 0}, [&neighbours](const Vec2<int>&, char c) {
+        neighbours += c;
+    });
+    check(neighbours == "bcd", "for_each_neighbor passes the cells of a GridView");
+    return aoctest::exit_code();
+}
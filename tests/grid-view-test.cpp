@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../aoclib/grid-view.hpp"
+#include "check.hpp"
+
+/*
+    FastDivisor against plain floor division (including numerators at the ends of the int64_t range, 
+    where the remainder must not overflow), WrappingGridView positions and tiles on a small grid, and text_grid_view
+    (blank lines around the grid, a missing final '\n', rows pointing into the text, and the lines it rejects).
+*/
+
+using aocutil::FastDivisor;
+using aocutil::Vec2;
+using aoctest::check;
+
+static bool divmod_matches(const FastDivisor& div, int64_t x)
+{
+    const int64_t d = div.divisor();
+    int64_t quot = x / d; // Rounds towards zero, i.e. one too large for negative x with a remainder.
+    if (x % d != 0 && x < 0) {
+        --quot;
+    }
+    const int64_t rem = x % d < 0 ? x % d + d : x % d;
+    const FastDivisor::DivMod res = div.divmod(x);
+    return res.quot == quot && res.rem == rem;
+}
+
+static bool throws_invalid_argument(std::string_view text)
+{
+    try {
+        static_cast<void>(aocutil::text_grid_view(text));
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+static void check_text_grid_view()
+{
+    const std::string text = "\n  \n#.a\n.#b\n\n\t\n";
+    const aocutil::GridView<const char> view = aocutil::text_grid_view(text);
+    check(view.width() == 3 && view.height() == 2 && view.stride() == 4, "size and stride of a view with blank lines around it");
+    check(view[{.x = 0, .y = 0}] == '#' && view[{.x = 2, .y = 0}] == 'a' && view[{.x = 1, .y = 1}] == '#' && view.at(2, 1) == 'b',
+          "cells skip the '\n' between the rows");
+    check(std::string_view {view.row(1).data(), view.row(1).size()} == ".#b" && view.row(0).data() == text.data() + 4,
+          "rows point into the text");
+    check(!view.try_get(3, 0) && !view.try_get(0, 2), "no cells outside the lines");
+    const aocutil::Grid<char> grid = view.to_grid();
+    check(grid.width() == 3 && grid.height() == 2 && grid.get(2, 1) == 'b', "to_grid() copies the cells");
+
+    const aocutil::GridView<const char> last_line = aocutil::text_grid_view("ab\ncd");
+    check(last_line.height() == 2 && last_line[{.x = 1, .y = 1}] == 'd', "a last line without '\\n'");
+    check(aocutil::text_grid_view("").height() == 0 && aocutil::text_grid_view("\n \n").height() == 0, "no grid in blank text");
+    check(throws_invalid_argument("ab\nabc\n") && throws_invalid_argument("ab\ncd\n\nef\n"),
+          "lines of different width or a blank line within the grid throw");
+}
+
+int main()
+{
+    constexpr int64_t min = std::numeric_limits<int64_t>::min(), max = std::numeric_limits<int64_t>::max();
+    const std::vector<int64_t> divisors {1, 2, 3, 7, 64, 131, 1000, 65537, (int64_t {1} << 31) + 11, std::numeric_limits<uint32_t>::max()};
+    std::mt19937_64 rng {16};
+    bool all_match = true;
+    for (int64_t d : divisors) {
+        const FastDivisor div {d};
+        for (int64_t x : {min, min + 1, min + 2, min + d, -d - 1, -d, -d + 1, int64_t {-1}, int64_t {0}, int64_t {1}, d - 1, d, d + 1, max - d, max - 1, max}) {
+            all_match = all_match && divmod_matches(div, x);
+        }
+        for (int i = 0; i < 10000; ++i) {
+            all_match = all_match && divmod_matches(div, static_cast<int64_t>(rng()));
+        }
+    }
+    check(all_match, "FastDivisor::divmod matches floor division");
+
+    const std::vector<std::string> rows {"abc", "def"};
+    const aocutil::Grid<char> grid {std::span<const std::string> {rows}};
+    const aocutil::WrappingGridView<char> wrapping {grid};
+    const auto wrapped = wrapping.wrap({.x = -1, .y = 5});
+    check(wrapped.pos == Vec2<int> {.x = 2, .y = 1} && wrapped.tile == Vec2<int64_t> {.x = -1, .y = 2}, "wrap (-1, 5)");
+    check(wrapping[{.x = 3 * 1000000 + 1, .y = -2 * 7}] == 'b' && wrapping[{.x = min, .y = max}] == grid[{.x = 1, .y = 1}], 
+          "elements of far away tiles");
+
+    check_text_grid_view();
+    return aoctest::exit_code();
+}
@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+#include "../aoclib/grid-zobrist.hpp"
+#include "check.hpp"
+
+/*
+    ZobristGrid on random grids: the key is invariant under rotations, and after any mix of set(), rotate_cw() and rotate_ccw()
+    the incrementally updated key equals the key computed from scratch (for the same orientation as at construction).
+*/
+
+using aocutil::Grid;
+using aocutil::ZobristGrid;
+using aoctest::check;
+
+static constexpr char cell_chars[] = ".O#";
+
+static Grid<char> random_grid(std::mt19937& rng)
+{
+    const int width = 1 + static_cast<int>(rng() % 12), height = 1 + static_cast<int>(rng() % 12);
+    std::vector<char> cells(static_cast<std::size_t>(width) * height);
+    for (char& c : cells) {
+        c = cell_chars[rng() % 3];
+    }
+    return Grid<char> {width, height, std::span<const char> {cells}};
+}
+
+static bool same_cells(const Grid<char>& a, const Grid<char>& b)
+{
+    if (a.width() != b.width() || a.height() != b.height()) {
+        return false;
+    }
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            if (a.get(x, y) != b.get(x, y)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void check_rotations()
+{
+    std::mt19937 rng {21};
+    bool invariant = true;
+    for (int round = 0; round < 200; ++round) {
+        ZobristGrid<char> grid {random_grid(rng)};
+        const uint64_t key = grid.key();
+        for (int i = 0; i < 4; ++i) {
+            grid.rotate_cw();
+            invariant = invariant && grid.key() == key;
+        }
+        grid.rotate_ccw();
+        invariant = invariant && grid.key() == key;
+    }
+    check(invariant, "rotations don't change the key");
+}
+
+static void check_incremental_key()
+{
+    std::mt19937 rng {21};
+    bool keys_equal = true, cells_equal = true;
+    for (int round = 0; round < 200; ++round) {
+        Grid<char> expected = random_grid(rng);
+        ZobristGrid<char> grid {expected};
+        int rotation = 0;
+        for (int i = 0; i < 60; ++i) {
+            switch (rng() % 4) {
+            case 0:
+                grid.rotate_cw();
+                expected.rotate_cw();
+                rotation = (rotation + 1) % 4;
+                break;
+            case 1:
+                grid.rotate_ccw();
+                expected.rotate_ccw();
+                rotation = (rotation + 3) % 4;
+                break;
+            default:
+                const int x = static_cast<int>(rng() % expected.width()), y = static_cast<int>(rng() % expected.height());
+                const char elem = cell_chars[rng() % 3];
+                grid.set(x, y, elem);
+                expected.set(x, y, elem);
+            }
+        }
+        for (; rotation; rotation = (rotation + 3) % 4) {
+            grid.rotate_ccw();
+            expected.rotate_ccw();
+        }
+        keys_equal = keys_equal && grid.key() == ZobristGrid<char> {expected}.key();
+        cells_equal = cells_equal && same_cells(grid.grid(), expected);
+    }
+    check(keys_equal, "incremental key equals the recomputed key");
+    check(cells_equal, "cells equal a plain Grid after the same operations");
+}
+
+static void check_set()
+{
+    ZobristGrid<char> grid {Grid<char> {2, 2, std::span<const char> {"..O#", 4}}};
+    const uint64_t key = grid.key();
+    grid.set(0, 0, '#');
+    check(grid.key() != key, "set() of another element changes the key");
+    grid.set(0, 0, '.');
+    check(grid.key() == key, "setting the old element back restores the key");
+}
+
+int main()
+{
+    check_rotations();
+    check_incremental_key();
+    check_set();
+    return aoctest::exit_code();
+}
@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../aoclib/input-cache.hpp"
+#include "check.hpp"
+
+/*
+    A cache only counts for the same input hash and schema tag; a section read as the wrong type, a truncated
+    or a garbage file is a cache miss (no exception), and rewriting the cache replaces the old one.
+*/
+
+using aoctest::check;
+
+struct Pair {
+    int32_t a, b;
+};
+
+int main()
+{
+    if constexpr (!aocio::input_cache_supported) {
+        return aoctest::exit_code();
+    }
+    const std::string path = (std::filesystem::temp_directory_path() / ("aoc-input-cache-test-" + std::to_string(::getpid()) + ".cache")).string();
+    const std::vector<Pair> pairs {{1, 2}, {3, 4}, {5, 6}};
+    const std::vector<char> chars {'a', 'b'};
+
+    aocio::CacheWriter writer;
+    writer.add(pairs);
+    writer.add(chars);
+    check(writer.write(path, 42, "test pairs v1"), "cache written");
+
+    {
+        aocio::InputCache cache;
+        check(cache.open(path, 42, "test pairs v1"), "same input and schema: hit");
+        const auto got = cache.get<Pair>(0);
+        check(got && got->size() == 3 && (*got)[2].a == 5 && (*got)[2].b == 6, "section read back");
+        check(!cache.get<int64_t>(1), "section of another element size: nullopt");
+        check(!cache.get<char>(2), "missing section: nullopt");
+    }
+    {
+        aocio::InputCache cache;
+        check(!cache.open(path, 43, "test pairs v1"), "other input hash: miss");
+        check(!cache.open(path, 42, "test pairs v2"), "other schema tag: miss");
+    }
+
+    aocio::CacheWriter rewriter;
+    rewriter.add(std::vector<Pair> {{7, 8}});
+    check(rewriter.write(path, 42, "test pairs v2"), "cache rewritten");
+    {
+        aocio::InputCache cache;
+        check(!cache.open(path, 42, "test pairs v1"), "old schema tag after rewrite: miss");
+        check(cache.open(path, 42, "test pairs v2"), "new schema tag after rewrite: hit");
+        const auto got = cache.get<Pair>(0);
+        check(got && got->size() == 1 && got->front().a == 7, "rewritten section read back");
+    }
+
+    std::filesystem::resize_file(path, 40); // Within the section table.
+    {
+        aocio::InputCache cache;
+        check(!cache.open(path, 42, "test pairs v2"), "truncated file: miss");
+    }
+    {
+        std::ofstream file {path, std::ios::binary | std::ios::trunc};
+        file << "not a cache at all, just some text";
+    }
+    {
+        aocio::InputCache cache;
+        check(!cache.open(path, 42, "test pairs v2"), "garbage file: miss");
+    }
+
+    std::filesystem::remove(path);
+    return aoctest::exit_code();
+}
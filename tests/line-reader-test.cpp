@@ -0,0 +1,100 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h>
+#include "../aoclib/aocio.hpp"
+#include "check.hpp"
+
+/*
+    LineReader against split_lines (i.e. the line semantics of file_getlines) with tiny buffers, so lines span refills
+    and lines longer than the buffer make it grow: empty files, empty lines, files with and without a final newline,
+    random files; rewind() in the middle of and after a pass, and a missing file.
+*/
+
+using aoctest::check;
+
+static const std::string path = (std::filesystem::temp_directory_path() / ("aoc-line-reader-test-" + std::to_string(::getpid()) + ".txt")).string();
+
+static void write_file(std::string_view contents)
+{
+    std::ofstream file {path, std::ios::binary | std::ios::trunc};
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+static std::vector<std::string> read_all(aocio::LineReader& reader)
+{
+    std::vector<std::string> lines;
+    for (std::string_view line : reader) {
+        lines.emplace_back(line);
+    }
+    return lines;
+}
+
+// All lines of contents, read with a buffer of buffer_size bytes, equal split_lines (also after a rewind).
+static bool reads_like_split_lines(std::string_view contents, std::size_t buffer_size)
+{
+    write_file(contents);
+    aocio::LineReader reader {buffer_size};
+    if (!reader.open(path)) {
+        return false;
+    }
+    const std::vector<std::string> expected = aocio::split_lines<std::string>(contents);
+    std::string_view line;
+    const bool first_pass = read_all(reader) == expected && !reader.next(line); // Stays at the end.
+    return first_pass && reader.rewind() && read_all(reader) == expected;
+}
+
+static void check_fixed_files()
+{
+    bool all_equal = true;
+    for (std::size_t buffer_size : {1, 2, 3, 4, 7, 64}) {
+        for (std::string_view contents : {"", "\n", "\n\n\n", "a", "a\n", "abc\ndef", "abc\ndef\n", "\nab\n\ncd", "abcdefgh\nij\n"}) {
+            all_equal = all_equal && reads_like_split_lines(contents, buffer_size);
+        }
+    }
+    check(all_equal, "empty lines, missing final newlines and lines spanning refills");
+
+    const std::string long_line(1000, 'x');
+    check(reads_like_split_lines("ab\n" + long_line + "\ncd", 8) && reads_like_split_lines(long_line, 8),
+          "a line much longer than the buffer (which grows)");
+}
+
+static void check_random_files()
+{
+    std::mt19937 rng {5};
+    bool all_equal = true;
+    for (int round = 0; round < 200; ++round) {
+        std::string contents(rng() % 300, '\n');
+        for (char& c : contents) {
+            c = rng() % 8 == 0 ? '\n' : static_cast<char>('a' + rng() % 26);
+        }
+        all_equal = all_equal && reads_like_split_lines(contents, 1 + rng() % 32);
+    }
+    check(all_equal, "random files with random buffer sizes");
+}
+
+static void check_rewind()
+{
+    write_file("one\ntwo\nthree\n");
+    aocio::LineReader reader {4};
+    check(!reader.rewind(), "rewind() of a reader without a file fails");
+    check(reader.open(path), "file opened");
+    std::string_view line;
+    check(reader.next(line) && line == "one" && reader.next(line) && line == "two", "first lines");
+    check(reader.rewind() && read_all(reader) == std::vector<std::string> {"one", "two", "three"}, "rewind() in the middle of a pass");
+
+    aocio::LineReader missing;
+    check(!missing.open(path + ".missing"), "a missing file is not opened");
+}
+
+int main()
+{
+    check_fixed_files();
+    check_random_files();
+    check_rewind();
+    std::filesystem::remove(path);
+    return aoctest::exit_code();
+}